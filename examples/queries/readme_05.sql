@@ -5,7 +5,7 @@ SELECT
   "STAROST",
   "POLLETJE",
   "SPOL",
-  TRY_CAST(value AS DOUBLE) AS value_num
+  value AS value_num
 FROM SISTAT_Read('05C1002S', language := 'en')
-WHERE value IS NOT NULL AND value <> '' AND value <> '-'
+WHERE value IS NOT NULL
 LIMIT 500;
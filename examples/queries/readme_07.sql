@@ -15,12 +15,12 @@ ORDER BY position;
 CREATE OR REPLACE TABLE population_data AS
 SELECT *
 FROM SISTAT_Read('05C1002S', language := 'en')
-WHERE value IS NOT NULL AND value <> '' AND value <> '-';
+WHERE value IS NOT NULL;
 
 -- 4) Run analysis
 SELECT
   "SPOL" AS sex_code,
-  AVG(TRY_CAST(value AS DOUBLE)) AS avg_value
+  AVG(value) AS avg_value
 FROM population_data
 GROUP BY 1
 ORDER BY 1;
@@ -7,29 +7,16 @@ WITH latest_year AS (
 agg AS (
   SELECT
     "VINSKE SORTE" AS sort_code,
-    SUM(TRY_CAST(value AS DOUBLE)) AS area_ha
+    SUM(value) AS area_ha
   FROM SISTAT_Read('1528317S', language := 'sl'), latest_year
   WHERE value IS NOT NULL
-    AND value <> ''
     AND TRY_CAST("LETO" AS INTEGER) = latest_year.y
   GROUP BY 1
 ),
-dim AS (
-  SELECT value_codes, value_texts
-  FROM SISTAT_DataStructure('1528317S', language := 'sl')
-  WHERE variable_code = 'VINSKE SORTE'
-),
 labels AS (
-  SELECT
-    list_extract(code_list, i) AS sort_code,
-    list_extract(text_list, i) AS raw_name
-  FROM (
-    SELECT
-      string_split(replace(replace(replace(value_codes, '[', ''), ']', ''), '"', ''), ',') AS code_list,
-      string_split(replace(replace(replace(value_texts, '[', ''), ']', ''), '"', ''), ',') AS text_list
-    FROM dim
-  ) s,
-  range(1, length(code_list) + 1) t(i)
+  SELECT code AS sort_code, text AS raw_name
+  FROM SISTAT_DataStructureValues('1528317S', language := 'sl')
+  WHERE variable_code = 'VINSKE SORTE'
 ),
 named AS (
   SELECT
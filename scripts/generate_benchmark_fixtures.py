@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Generate the synthetic cubes read by the benchmarks in benchmark/sistat.
+
+Every cube is written twice, as json-stat 2.0 and as PX, the two formats SISTAT_Read asks PxWeb for, so the decode
+paths can be compared on identical data. Output is deterministic, so timings stay comparable between runs.
+
+Shapes:
+  wide    few large dimensions
+  deep    many dimensions of ten values each
+  sparse  the wide layout with most cells missing and carrying a status symbol instead
+
+Usage: scripts/generate_benchmark_fixtures.py [--large] [--output benchmark/fixtures]
+The 50m cubes are only written with --large; they take several GB of disk and a few minutes to generate.
+"""
+
+import argparse
+import json
+import os
+import random
+
+SIZES = {
+    "10k": 10_000,
+    "1m": 1_000_000,
+    "50m": 50_000_000,
+}
+
+# Dimension sizes of each shape, keyed by cube size; their product is the number of cells
+SHAPES = {
+    "wide": {"10k": [10, 1000], "1m": [1000, 1000], "50m": [50, 1000, 1000]},
+    "deep": {"10k": [10] * 4, "1m": [10] * 6, "50m": [5] + [10] * 7},
+    "sparse": {"10k": [10, 1000], "1m": [1000, 1000], "50m": [50, 1000, 1000]},
+}
+
+# Share of missing cells in the sparse shape, and the symbols they carry
+SPARSE_MISSING = 0.7
+SYMBOLS = ["-", "...", "z", "M", "N"]
+
+# Cells written per line of PX data and per write call
+CHUNK = 10_000
+
+
+def dimension_ids(sizes):
+    return ["D%d" % (d + 1) for d in range(len(sizes))]
+
+
+def dimension_codes(d, size):
+    return ["%d_%d" % (d + 1, i) for i in range(size)]
+
+
+def cells(shape, total):
+    """Yield (value, status) for every cell in row-major order; value is None for missing cells."""
+    rng = random.Random(20240101)
+    missing = SPARSE_MISSING if shape == "sparse" else 0.0
+    for _ in range(total):
+        if rng.random() < missing:
+            yield None, SYMBOLS[rng.randrange(len(SYMBOLS))]
+        else:
+            yield round(rng.random() * 10000, 1), None
+
+
+def write_json_stat(path, shape, sizes, total):
+    ids = dimension_ids(sizes)
+    dimension = {}
+    for d, (dim_id, size) in enumerate(zip(ids, sizes)):
+        codes = dimension_codes(d, size)
+        dimension[dim_id] = {
+            "label": "Dimension %d" % (d + 1),
+            "category": {
+                "index": {code: i for i, code in enumerate(codes)},
+                "label": {code: "Value %s" % code for code in codes},
+            },
+        }
+    head = {
+        "class": "dataset",
+        "label": "Benchmark cube %s" % os.path.basename(path),
+        "source": "generate_benchmark_fixtures.py",
+        "version": "2.0",
+        "id": ids,
+        "size": sizes,
+        "dimension": dimension,
+    }
+    statuses = {}
+    with open(path, "w") as f:
+        # The value array is streamed rather than built as one Python list, which would not fit for 50m cells
+        f.write(json.dumps(head)[:-1])
+        f.write(', "value": [')
+        buffer = []
+        for cell, (value, status) in enumerate(cells(shape, total)):
+            buffer.append("null" if value is None else repr(value))
+            if status is not None:
+                statuses[str(cell)] = status
+            if len(buffer) == CHUNK:
+                f.write(("," if cell >= CHUNK else "") + ",".join(buffer))
+                buffer = []
+        if buffer:
+            f.write(("," if total > len(buffer) else "") + ",".join(buffer))
+        f.write("]")
+        if statuses:
+            f.write(', "status": ')
+            f.write(json.dumps(statuses))
+        f.write("}\n")
+
+
+def px_list(values):
+    return ",".join('"%s"' % v for v in values)
+
+
+def write_px(path, shape, sizes, total):
+    ids = dimension_ids(sizes)
+    with open(path, "w") as f:
+        f.write('CHARSET="ANSI";\n')
+        f.write('MATRIX="%s";\n' % os.path.splitext(os.path.basename(path))[0])
+        f.write('TITLE="Benchmark cube";\n')
+        f.write("STUB=%s;\n" % px_list(ids[:-1]))
+        f.write("HEADING=%s;\n" % px_list(ids[-1:]))
+        for d, (dim_id, size) in enumerate(zip(ids, sizes)):
+            f.write('VALUES("%s")=%s;\n' % (dim_id, px_list(dimension_codes(d, size))))
+        f.write("DATA=\n")
+        buffer = []
+        for value, status in cells(shape, total):
+            buffer.append('"%s"' % status if value is None else repr(value))
+            if len(buffer) == CHUNK:
+                f.write(" ".join(buffer) + "\n")
+                buffer = []
+        if buffer:
+            f.write(" ".join(buffer) + "\n")
+        f.write(";\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--output", default=os.path.join("benchmark", "fixtures"))
+    parser.add_argument("--large", action="store_true", help="also write the 50m cubes")
+    args = parser.parse_args()
+
+    os.makedirs(args.output, exist_ok=True)
+    for shape, layouts in SHAPES.items():
+        for size_name, total in SIZES.items():
+            if size_name == "50m" and not args.large:
+                continue
+            sizes = layouts[size_name]
+            product = 1
+            for size in sizes:
+                product *= size
+            assert product == total, (shape, size_name)
+            base = os.path.join(args.output, "%s_%s" % (shape, size_name))
+            write_json_stat(base + ".json", shape, sizes, total)
+            write_px(base + ".px", shape, sizes, total)
+            print("wrote %s.json and %s.px" % (base, base))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,41 @@
+#!/usr/bin/env bash
+# Run the offline decode benchmarks and report the peak memory of each decode.
+#
+# Build with BUILD_BENCHMARK=1 make first and generate the fixtures with scripts/generate_benchmark_fixtures.py.
+# Timings come from DuckDB's benchmark runner; it does not track memory, so the peak resident set size of a full
+# decode is measured separately with the DuckDB shell under /usr/bin/time.
+set -euo pipefail
+
+PATTERN="${1:-benchmark/sistat/.*}"
+RUNNER="${2:-./build/release/benchmark/benchmark_runner}"
+DB_BIN="${3:-./build/release/duckdb}"
+FIXTURE_DIR="${4:-benchmark/fixtures}"
+
+shopt -s nullglob
+fixtures=("${FIXTURE_DIR}"/*.json "${FIXTURE_DIR}"/*.px)
+if [ "${#fixtures[@]}" -eq 0 ]; then
+	echo "No fixtures in ${FIXTURE_DIR}; run scripts/generate_benchmark_fixtures.py first" >&2
+	exit 1
+fi
+
+# Benchmarks whose fixture was not generated (the 50m cubes without --large) are skipped
+benchmarks=()
+for benchmark in benchmark/sistat/*/*.benchmark; do
+	name="$(basename "${benchmark}" .benchmark)"
+	fixture="${FIXTURE_DIR}/${name%_*}.${name##*_}"
+	if [[ "${benchmark}" =~ ${PATTERN} ]] && [ -f "${fixture}" ]; then
+		benchmarks+=("${benchmark}")
+	fi
+done
+
+for benchmark in "${benchmarks[@]}"; do
+	"${RUNNER}" "${benchmark}"
+done
+
+echo
+echo "fixture	peak_rss_kb"
+for fixture in "${fixtures[@]}"; do
+	peak="$(/usr/bin/time -f '%M' "${DB_BIN}" ":memory:" \
+		-c "SELECT COUNT(*) FROM SISTAT_ReadFile('${fixture}')" 2>&1 >/dev/null | tail -n 1)"
+	echo "$(basename "${fixture}")	${peak}"
+done
@@ -1,4 +1,6 @@
 #include "http_request.hpp"
+#include "sistat.hpp"
+#include "miniz.hpp"
 
 #include "duckdb/common/file_opener.hpp"
 #include "duckdb/common/gzip_file_system.hpp"
@@ -7,15 +9,26 @@
 #include "duckdb/main/client_context.hpp"
 #include "duckdb/main/client_context_file_opener.hpp"
 #include "duckdb/main/settings.hpp"
-
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <algorithm>
+#include <cctype>
 #include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstring>
 #include <thread>
 
 namespace duckdb {
 
-static constexpr idx_t DEFAULT_HTTP_MAX_CONCURRENT = 32;
-static constexpr idx_t DEFAULT_HTTP_RETRY_COUNT = 4;
-static constexpr idx_t DEFAULT_HTTP_RETRY_BACKOFF_MS = 250;
+static constexpr idx_t HTTP_POOL_MAX_IDLE_CLIENTS = 64;
+static constexpr int64_t HTTP_POOL_IDLE_TIMEOUT_SEC = 30;
+//! How often a cancellable request waiting for a free slot of its host checks whether it was cancelled
+static constexpr int64_t CANCELLED_WINDOW_CHECK_MS = 50;
 
 static void ParseUrl(const string &url, string &proto_host_port, string &path) {
 	auto scheme_end = url.find("://");
@@ -66,6 +79,247 @@ static bool IsRetryableError(duckdb_httplib_openssl::Error error) {
 	}
 }
 
+static bool IsRetryableStatus(int status) {
+	return status == 429 || status == 500 || status == 502 || status == 503 || status == 504;
+}
+
+static bool IsThrottledStatus(int status) {
+	return status == 429 || status == 503;
+}
+
+//! Delay requested by a Retry-After header given in seconds; HTTP dates are ignored in favour of the backoff
+static int64_t RetryAfterMs(const duckdb_httplib_openssl::Response &response) {
+	auto value = response.get_header_value("Retry-After");
+	auto is_digit = [](char c) {
+		return std::isdigit(static_cast<unsigned char>(c)) != 0;
+	};
+	if (value.empty() || !std::all_of(value.begin(), value.end(), is_digit)) {
+		return 0;
+	}
+	try {
+		return static_cast<int64_t>(std::stoll(value)) * 1000;
+	} catch (...) {
+		return 0;
+	}
+}
+
+//! Capped exponential backoff with full jitter, so clients that failed together do not retry together
+static int64_t BackoffMs(const HttpSettings &settings, idx_t attempt, int64_t retry_after_ms) {
+	auto cap = static_cast<double>(settings.retry_max_wait_ms);
+	auto ceiling = MinValue<double>(cap, static_cast<double>(settings.retry_wait_ms) * std::pow(2.0, attempt - 1));
+	RandomEngine random;
+	auto delay = static_cast<int64_t>(random.NextRandom() * ceiling);
+	return MaxValue<int64_t>(delay, MinValue<int64_t>(retry_after_ms, static_cast<int64_t>(cap)));
+}
+
+void HttpCancellation::Cancel() {
+	lock_guard<mutex> guard(lock);
+	cancelled = true;
+	for (auto client : clients) {
+		// Shuts the socket down, so a read blocked on a stalled connection returns at once
+		client->stop();
+	}
+	cancelled_cv.notify_all();
+}
+
+bool HttpCancellation::Sleep(std::chrono::microseconds duration) {
+	unique_lock<mutex> guard(lock);
+	return !cancelled_cv.wait_for(guard, duration, [&]() { return cancelled.load(); });
+}
+
+bool HttpCancellation::AddClient(duckdb_httplib_openssl::Client &client) {
+	lock_guard<mutex> guard(lock);
+	if (cancelled) {
+		return false;
+	}
+	clients.insert(&client);
+	return true;
+}
+
+void HttpCancellation::RemoveClient(duckdb_httplib_openssl::Client &client) {
+	lock_guard<mutex> guard(lock);
+	clients.erase(&client);
+}
+
+static bool IsCancelled(const HttpSettings &settings) {
+	return settings.cancellation && settings.cancellation->IsCancelled();
+}
+
+//! Sleep for `duration`, ending early when the call is cancelled; false when it was
+static bool SleepUnlessCancelled(const HttpSettings &settings, std::chrono::microseconds duration) {
+	if (settings.cancellation) {
+		return settings.cancellation->Sleep(duration);
+	}
+	std::this_thread::sleep_for(duration);
+	return true;
+}
+
+//! Pacing of the requests sent to one host by the queries of a database. A token bucket caps the request rate,
+//! and an AIMD window caps the requests in flight: it halves when the server answers 429/503 and grows by one per
+//! window of successful requests, up to the global `sistat_max_concurrency`.
+class HostThrottle {
+public:
+	//! Wait for a slot; false when the call was cancelled while waiting
+	bool Acquire(const HttpSettings &settings) {
+		auto max_window = static_cast<double>(MaxValue<uint64_t>(settings.host_concurrency, 1));
+		unique_lock<mutex> guard(lock);
+		while (true) {
+			if (IsCancelled(settings)) {
+				return false;
+			}
+			if (window <= 0 || window > max_window) {
+				window = max_window;
+			}
+			if (in_flight >= MaxValue<idx_t>(static_cast<idx_t>(window), 1)) {
+				// Cancellation does not signal this condition, so a cancellable wait looks again now and then
+				if (settings.cancellation) {
+					window_cv.wait_for(guard, std::chrono::milliseconds(CANCELLED_WINDOW_CHECK_MS));
+				} else {
+					window_cv.wait(guard);
+				}
+				continue;
+			}
+			auto wait = TakeToken(settings);
+			if (wait.count() <= 0) {
+				break;
+			}
+			guard.unlock();
+			if (!SleepUnlessCancelled(settings, wait)) {
+				return false;
+			}
+			guard.lock();
+		}
+		in_flight++;
+		return true;
+	}
+
+	void Release(bool throttled) {
+		lock_guard<mutex> guard(lock);
+		in_flight--;
+		if (throttled) {
+			window = MaxValue<double>(window / 2, 1);
+		} else if (window > 0) {
+			window += 1 / window;
+		}
+		window_cv.notify_all();
+	}
+
+private:
+	//! Take a token, or return how long to wait for the next one
+	std::chrono::microseconds TakeToken(const HttpSettings &settings) {
+		if (settings.requests_per_second <= 0) {
+			return std::chrono::microseconds(0);
+		}
+		auto burst = static_cast<double>(MaxValue<uint64_t>(settings.request_burst, 1));
+		auto now = std::chrono::steady_clock::now();
+		if (!bucket_started) {
+			tokens = burst;
+			bucket_started = true;
+		} else {
+			std::chrono::duration<double> elapsed = now - last_refill;
+			tokens = MinValue<double>(burst, tokens + elapsed.count() * settings.requests_per_second);
+		}
+		last_refill = now;
+		if (tokens >= 1) {
+			tokens -= 1;
+			return std::chrono::microseconds(0);
+		}
+		return std::chrono::microseconds(static_cast<int64_t>((1 - tokens) / settings.requests_per_second * 1e6) + 1);
+	}
+
+	mutex lock;
+	std::condition_variable window_cv;
+	//! Requests allowed in flight; 0 until the first request sets it to the configured concurrency
+	double window = 0;
+	idx_t in_flight = 0;
+	bool bucket_started = false;
+	double tokens = 0;
+	std::chrono::steady_clock::time_point last_refill;
+};
+
+//! Throttles of the hosts a database sends requests to, kept in its object cache so all its connections share them
+class HostThrottles : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "sistat_host_throttles";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	optional_idx GetEstimatedCacheMemory() const override {
+		return sizeof(HostThrottles);
+	}
+
+	static shared_ptr<HostThrottles> Get(ClientContext &context) {
+		return ObjectCache::GetObjectCache(context).GetOrCreate<HostThrottles>(ObjectType());
+	}
+
+	HostThrottle &ForHost(const string &host) {
+		lock_guard<mutex> guard(lock);
+		auto &throttle = throttles[host];
+		if (!throttle) {
+			throttle = make_uniq<HostThrottle>();
+		}
+		return *throttle;
+	}
+
+private:
+	mutex lock;
+	unordered_map<string, unique_ptr<HostThrottle>> throttles;
+};
+
+//! Holds a throttle slot for one attempt; released early before backing off so waiting does not hold a slot
+class ThrottleSlot {
+public:
+	ThrottleSlot(HostThrottle &throttle_p, const HttpSettings &settings) : throttle(throttle_p) {
+		held = throttle.Acquire(settings);
+	}
+	~ThrottleSlot() {
+		Release(false);
+	}
+	void Release(bool throttled) {
+		if (held) {
+			held = false;
+			throttle.Release(throttled);
+		}
+	}
+	//! False when the call was cancelled before a slot was free
+	bool Held() const {
+		return held;
+	}
+
+private:
+	HostThrottle &throttle;
+	bool held = false;
+};
+
+//! Registers the client of an attempt with the call's cancellation while its request is sent
+class CancellableSend {
+public:
+	CancellableSend(const HttpSettings &settings, duckdb_httplib_openssl::Client &client_p)
+	    : cancellation(settings.cancellation), client(client_p) {
+		registered = !cancellation || cancellation->AddClient(client);
+	}
+	~CancellableSend() {
+		if (cancellation && registered) {
+			cancellation->RemoveClient(client);
+		}
+	}
+	//! False when the call was cancelled before the request could be sent
+	bool Registered() const {
+		return registered;
+	}
+
+private:
+	shared_ptr<HttpCancellation> cancellation;
+	duckdb_httplib_openssl::Client &client;
+	bool registered;
+};
+
+static string FormatCancelledError(const string &url, const string &method) {
+	return StringUtil::Format("HTTP request cancelled: %s %s", method.c_str(), url.c_str());
+}
+
 static string FormatTransportError(const string &url, const string &method, duckdb_httplib_openssl::Error error,
                                    idx_t attempt, idx_t max_attempts) {
 	return StringUtil::Format("HTTP transport error (%s) for %s %s [attempt %d/%d]",
@@ -73,6 +327,376 @@ static string FormatTransportError(const string &url, const string &method, duck
 	                          static_cast<int>(attempt), static_cast<int>(max_attempts));
 }
 
+//! Split the time of one attempt into its phases. Receiver time is left out: decoders record it themselves.
+static void RecordPhases(const StatsRecorder &stats, std::chrono::steady_clock::time_point send_start,
+                         std::chrono::steady_clock::time_point socket_created,
+                         std::chrono::steady_clock::time_point headers_received, bool has_headers, uint64_t content_us,
+                         uint64_t receiver_us) {
+	auto micros = [](std::chrono::steady_clock::duration duration) {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+	};
+	auto now = std::chrono::steady_clock::now();
+	stats.Add(&SistatStats::dns_us, micros(socket_created - send_start));
+	if (!has_headers) {
+		stats.Add(&SistatStats::first_byte_us, micros(now - socket_created));
+		return;
+	}
+	stats.Add(&SistatStats::first_byte_us, micros(headers_received - socket_created));
+	auto body_us = micros(now - headers_received);
+	stats.Add(&SistatStats::transfer_us, body_us - MinValue(body_us, content_us));
+	stats.Add(&SistatStats::inflate_us, content_us - MinValue(content_us, receiver_us));
+}
+
+static unique_ptr<duckdb_httplib_openssl::Client> CreateClient(const HttpSettings &settings,
+                                                              const string &proto_host_port) {
+	auto client = make_uniq<duckdb_httplib_openssl::Client>(proto_host_port);
+	client->set_follow_location(settings.follow_redirects);
+	client->set_decompress(false);
+	client->enable_server_certificate_verification(settings.enable_server_cert_verification);
+	if (settings.enable_server_cert_verification && !settings.ca_cert_file.empty()) {
+		client->set_ca_cert_path(settings.ca_cert_file);
+	}
+
+	auto timeout_sec = static_cast<time_t>(settings.timeout);
+	client->set_read_timeout(timeout_sec, 0);
+	client->set_write_timeout(timeout_sec, 0);
+	client->set_connection_timeout(timeout_sec, 0);
+	client->set_keep_alive(settings.keep_alive);
+
+	if (!settings.proxy.empty()) {
+		string proxy_host;
+		idx_t proxy_port = 80;
+		string proxy_copy = settings.proxy;
+		HTTPUtil::ParseHTTPProxyHost(proxy_copy, proxy_host, proxy_port);
+		client->set_proxy(proxy_host, static_cast<int>(proxy_port));
+		if (!settings.proxy_username.empty()) {
+			client->set_proxy_basic_auth(settings.proxy_username, settings.proxy_password);
+		}
+	}
+	return client;
+}
+
+//! Idle clients, keyed by everything that shapes their connection, so keep-alive sockets and their TLS sessions
+//! (and the loaded CA bundle) survive from one request to the next. One pool per database, kept in its object
+//! cache and shared by its queries and connections.
+class HttpClientPool : public ObjectCacheEntry {
+public:
+	using Client = duckdb_httplib_openssl::Client;
+
+	static string ObjectType() {
+		return "sistat_http_client_pool";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	optional_idx GetEstimatedCacheMemory() const override {
+		return sizeof(HttpClientPool);
+	}
+
+	static shared_ptr<HttpClientPool> Get(ClientContext &context) {
+		return ObjectCache::GetObjectCache(context).GetOrCreate<HttpClientPool>(ObjectType());
+	}
+
+	//! Proxy credentials only enter the key as a hash, so they are not kept in plain text beside the clients
+	static string ClientKey(const HttpSettings &settings, const string &proto_host_port) {
+		auto credentials = settings.proxy_username + '\0' + settings.proxy_password;
+		auto credentials_hash = Hash(credentials.c_str(), credentials.size());
+		return StringUtil::Format("%s|%s|%llx|%d|%s|%d|%d", proto_host_port, settings.proxy,
+		                          static_cast<unsigned long long>(credentials_hash),
+		                          settings.enable_server_cert_verification ? 1 : 0, settings.ca_cert_file,
+		                          settings.timeout, settings.follow_redirects ? 1 : 0);
+	}
+
+	unique_ptr<Client> Acquire(const HttpSettings &settings, const string &key, const string &proto_host_port) {
+		{
+			lock_guard<mutex> guard(lock);
+			EvictExpired(std::chrono::steady_clock::now());
+			auto entry = idle_clients.find(key);
+			if (entry != idle_clients.end() && !entry->second.empty()) {
+				auto client = std::move(entry->second.back().client);
+				entry->second.pop_back();
+				idle_count--;
+				return client;
+			}
+		}
+		return CreateClient(settings, proto_host_port);
+	}
+
+	void Release(const HttpSettings &settings, const string &key, unique_ptr<Client> client) {
+		if (!settings.keep_alive) {
+			return;
+		}
+		lock_guard<mutex> guard(lock);
+		if (idle_count >= HTTP_POOL_MAX_IDLE_CLIENTS) {
+			return;
+		}
+		idle_clients[key].push_back(IdleClient {std::move(client), std::chrono::steady_clock::now()});
+		idle_count++;
+	}
+
+private:
+	struct IdleClient {
+		unique_ptr<Client> client;
+		std::chrono::steady_clock::time_point idle_since;
+	};
+
+	void EvictExpired(std::chrono::steady_clock::time_point now) {
+		auto cutoff = now - std::chrono::seconds(HTTP_POOL_IDLE_TIMEOUT_SEC);
+		for (auto entry = idle_clients.begin(); entry != idle_clients.end();) {
+			auto &clients = entry->second;
+			// Clients are pushed in release order, so the expired ones are at the front
+			idx_t expired = 0;
+			while (expired < clients.size() && clients[expired].idle_since < cutoff) {
+				expired++;
+			}
+			clients.erase(clients.begin(), clients.begin() + static_cast<int64_t>(expired));
+			idle_count -= expired;
+			entry = clients.empty() ? idle_clients.erase(entry) : std::next(entry);
+		}
+	}
+
+	mutex lock;
+	unordered_map<string, vector<IdleClient>> idle_clients;
+	idx_t idle_count = 0;
+};
+
+//! Decodes a gzip or deflate Content-Encoding while the body arrives, handing the output on in fixed-size blocks
+class ContentDecoder {
+public:
+	static constexpr idx_t OUTPUT_BLOCK_SIZE = 64 * 1024;
+
+	//! Decoder for a Content-Encoding header value; nullptr when the body is not encoded
+	static unique_ptr<ContentDecoder> Create(const string &content_encoding) {
+		auto encoding = StringUtil::Lower(content_encoding);
+		StringUtil::Trim(encoding);
+		if (encoding == "gzip" || encoding == "x-gzip") {
+			return make_uniq<ContentDecoder>(true);
+		}
+		if (encoding == "deflate") {
+			return make_uniq<ContentDecoder>(false);
+		}
+		return nullptr;
+	}
+
+	explicit ContentDecoder(bool gzip_p)
+	    : gzip(gzip_p), output(make_unsafe_uniq_array<unsigned char>(OUTPUT_BLOCK_SIZE)) {
+		memset(&stream, 0, sizeof(stream));
+		if (!gzip) {
+			// HTTP deflate is the zlib format
+			StartInflate(duckdb_miniz::MZ_DEFAULT_WINDOW_BITS);
+		}
+	}
+
+	~ContentDecoder() {
+		if (inflating) {
+			duckdb_miniz::mz_inflateEnd(&stream);
+		}
+	}
+
+	//! Decode a piece of the body; false when `sink` aborted
+	bool Feed(const char *data, idx_t size, const HttpBodyReceiver &sink) {
+		started = started || size > 0;
+		auto input = reinterpret_cast<const unsigned char *>(data);
+		while (size > 0) {
+			if (in_trailer) {
+				// CRC32 and size of a finished gzip member, which may span pieces
+				auto take = MinValue<idx_t>(GZIP_TRAILER_SIZE - trailer.size(), size);
+				trailer.append(reinterpret_cast<const char *>(input), take);
+				input += take;
+				size -= take;
+				if (trailer.size() == GZIP_TRAILER_SIZE) {
+					CheckTrailer();
+				}
+				continue;
+			}
+			if (!inflating) {
+				if (padding || (ended && header.empty() && input[0] == 0)) {
+					// NUL padding after the last member or zlib stream is skipped, as gzip does; other trailing
+					// bytes are rejected rather than silently dropped
+					padding = true;
+					for (idx_t i = 0; i < size; i++) {
+						if (input[i] != 0) {
+							throw IOException("HTTP: unexpected data after the %s response body",
+							                  gzip ? "gzip" : "deflate");
+						}
+					}
+					return true;
+				}
+				if (!gzip) {
+					throw IOException("HTTP: unexpected data after the deflate response body");
+				}
+				// Header of the next gzip member, which may span pieces
+				header.append(reinterpret_cast<const char *>(input), size);
+				auto header_size = GzipHeaderSize();
+				if (header_size == 0) {
+					return true;
+				}
+				StartInflate(-duckdb_miniz::MZ_DEFAULT_WINDOW_BITS);
+				string rest = header.substr(header_size);
+				header.clear();
+				return Inflate(reinterpret_cast<const unsigned char *>(rest.data()), rest.size(), sink);
+			}
+			return Inflate(input, size, sink);
+		}
+		return true;
+	}
+
+	//! Check that the body ended with a complete stream
+	void Finish() {
+		if (started && (inflating || in_trailer || !header.empty())) {
+			throw IOException("HTTP: truncated %s response body", gzip ? "gzip" : "deflate");
+		}
+	}
+
+private:
+	void StartInflate(int window_bits) {
+		memset(&stream, 0, sizeof(stream));
+		if (duckdb_miniz::mz_inflateInit2(&stream, window_bits) != duckdb_miniz::MZ_OK) {
+			throw IOException("HTTP: failed to initialize decompression");
+		}
+		inflating = true;
+		crc = MZ_CRC32_INIT;
+		output_size = 0;
+	}
+
+	//! Compare the trailer of a gzip member with the CRC32 and size (mod 2^32) of its decompressed data
+	void CheckTrailer() {
+		auto word = [&](idx_t offset) {
+			uint32_t value = 0;
+			for (idx_t i = 0; i < 4; i++) {
+				value |= static_cast<uint32_t>(static_cast<uint8_t>(trailer[offset + i])) << (8 * i);
+			}
+			return value;
+		};
+		if (word(0) != crc || word(4) != output_size) {
+			throw IOException("HTTP: gzip response body fails its CRC32 or size check");
+		}
+		in_trailer = false;
+		trailer.clear();
+	}
+
+	bool Inflate(const unsigned char *input, idx_t size, const HttpBodyReceiver &sink) {
+		stream.next_in = input;
+		stream.avail_in = static_cast<unsigned int>(size);
+		while (true) {
+			stream.next_out = output.get();
+			stream.avail_out = static_cast<unsigned int>(OUTPUT_BLOCK_SIZE);
+			auto status = duckdb_miniz::mz_inflate(&stream, duckdb_miniz::MZ_NO_FLUSH);
+			auto produced = OUTPUT_BLOCK_SIZE - stream.avail_out;
+			if (gzip && produced > 0) {
+				crc = static_cast<uint32_t>(duckdb_miniz::mz_crc32(crc, output.get(), produced));
+				output_size += static_cast<uint32_t>(produced);
+			}
+			if (produced > 0 && !sink(reinterpret_cast<const char *>(output.get()), produced)) {
+				return false;
+			}
+			if (status == duckdb_miniz::MZ_STREAM_END) {
+				duckdb_miniz::mz_inflateEnd(&stream);
+				inflating = false;
+				ended = true;
+				in_trailer = gzip;
+				// Anything left belongs to the trailer or to the next member
+				return Feed(reinterpret_cast<const char *>(stream.next_in), stream.avail_in, sink);
+			}
+			if (status != duckdb_miniz::MZ_OK && status != duckdb_miniz::MZ_BUF_ERROR) {
+				throw IOException("HTTP: invalid %s response body", gzip ? "gzip" : "deflate");
+			}
+			// Continue while input is left or the output block was filled, which may leave output pending
+			if (stream.avail_in == 0 && stream.avail_out > 0) {
+				return true;
+			}
+		}
+	}
+
+	//! Size of the buffered gzip member header, or 0 while it is incomplete
+	idx_t GzipHeaderSize() const {
+		static constexpr uint8_t FLAG_HCRC = 0x02;
+		static constexpr uint8_t FLAG_EXTRA = 0x04;
+		static constexpr uint8_t FLAG_NAME = 0x08;
+		static constexpr uint8_t FLAG_COMMENT = 0x10;
+		if (header.size() < 10) {
+			return 0;
+		}
+		if (static_cast<uint8_t>(header[0]) != 0x1f || static_cast<uint8_t>(header[1]) != 0x8b || header[2] != 8) {
+			throw IOException("HTTP: invalid gzip response body");
+		}
+		auto flags = static_cast<uint8_t>(header[3]);
+		idx_t pos = 10;
+		if (flags & FLAG_EXTRA) {
+			if (header.size() < pos + 2) {
+				return 0;
+			}
+			auto extra_low = static_cast<idx_t>(static_cast<uint8_t>(header[pos]));
+			auto extra_high = static_cast<idx_t>(static_cast<uint8_t>(header[pos + 1]));
+			pos += 2 + (extra_low | extra_high << 8);
+		}
+		for (auto flag : {FLAG_NAME, FLAG_COMMENT}) {
+			if (flags & flag) {
+				auto end = header.find('\0', pos);
+				if (end == string::npos) {
+					return 0;
+				}
+				pos = end + 1;
+			}
+		}
+		if (flags & FLAG_HCRC) {
+			pos += 2;
+		}
+		return header.size() >= pos ? pos : 0;
+	}
+
+	static constexpr idx_t GZIP_TRAILER_SIZE = 8;
+
+	bool gzip;
+	unsafe_unique_array<unsigned char> output;
+	duckdb_miniz::mz_stream stream;
+	bool inflating = false;
+	bool started = false;
+	string header;
+	//! Running CRC32 and size of the decompressed data of the current gzip member
+	uint32_t crc = MZ_CRC32_INIT;
+	uint32_t output_size = 0;
+	bool in_trailer = false;
+	string trailer;
+	//! Set once a member or the zlib stream ended, and once NUL padding follows it
+	bool ended = false;
+	bool padding = false;
+};
+
+static void CollectHeaders(const duckdb_httplib_openssl::Headers &headers, HttpResponseData &result) {
+	for (auto &header : headers) {
+		string normalized_key = NormalizeHeaderName(header.first);
+		if (StringUtil::CIEquals(header.first, "Content-Type")) {
+			result.content_type = header.second;
+		} else if (StringUtil::CIEquals(header.first, "Content-Length")) {
+			try {
+				result.content_length = std::stoll(header.second);
+			} catch (...) {
+			}
+		}
+		bool found = false;
+		for (idx_t i = 0; i < result.header_keys.size(); i++) {
+			if (StringUtil::CIEquals(result.header_keys[i].GetValue<string>(), normalized_key)) {
+				result.header_values[i] = Value(header.second);
+				found = true;
+				break;
+			}
+		}
+		if (!found) {
+			result.header_keys.push_back(Value(normalized_key));
+			result.header_values.push_back(Value(header.second));
+		}
+	}
+}
+
+template <class T>
+static void TryGetGlobalSetting(DatabaseInstance &db, const char *name, T &result) {
+	Value value;
+	if (db.TryGetCurrentSetting(name, value) && !value.IsNull()) {
+		result = value.GetValue<T>();
+	}
+}
+
 HttpSettings HttpRequest::ExtractHttpSettings(ClientContext &context, const string &url) {
 
 	HttpSettings settings;
@@ -82,9 +706,18 @@ HttpSettings HttpRequest::ExtractHttpSettings(ClientContext &context, const stri
 	settings.timeout = 30;
 	settings.keep_alive = true;
 	settings.enable_server_cert_verification = true;
-	settings.max_concurrency = DEFAULT_HTTP_MAX_CONCURRENT;
-	settings.use_cache = true;
+	settings.max_concurrency = sistat::DEFAULT_MAX_CONCURRENCY;
 	settings.follow_redirects = true;
+	settings.cache_max_size = sistat::DEFAULT_CACHE_MAX_SIZE;
+	settings.cache_max_age = sistat::DEFAULT_CACHE_MAX_AGE;
+	settings.requests_per_second = sistat::DEFAULT_REQUESTS_PER_SECOND;
+	settings.request_burst = sistat::DEFAULT_REQUEST_BURST;
+	settings.retries = sistat::DEFAULT_RETRIES;
+	settings.retry_wait_ms = sistat::DEFAULT_RETRY_WAIT_MS;
+	settings.retry_max_wait_ms = sistat::DEFAULT_RETRY_MAX_WAIT_MS;
+	settings.stats.database = DatabaseStats::Get(context);
+	settings.client_pool = HttpClientPool::Get(context);
+	settings.throttles = HostThrottles::Get(context);
 
 	ClientContextFileOpener opener(context);
 	FileOpenerInfo info;
@@ -99,6 +732,20 @@ HttpSettings HttpRequest::ExtractHttpSettings(ClientContext &context, const stri
 	FileOpener::TryGetCurrentSetting(&opener, "http_proxy_username", settings.proxy_username, &info);
 	FileOpener::TryGetCurrentSetting(&opener, "http_proxy_password", settings.proxy_password, &info);
 	FileOpener::TryGetCurrentSetting(&opener, "ca_cert_file", settings.ca_cert_file, &info);
+	FileOpener::TryGetCurrentSetting(&opener, sistat::MAX_CONCURRENCY_SETTING, settings.max_concurrency, &info);
+	FileOpener::TryGetCurrentSetting(&opener, sistat::CACHE_DIRECTORY_SETTING, settings.cache_directory, &info);
+	FileOpener::TryGetCurrentSetting(&opener, sistat::CACHE_MAX_SIZE_SETTING, settings.cache_max_size, &info);
+	FileOpener::TryGetCurrentSetting(&opener, sistat::CACHE_MAX_AGE_SETTING, settings.cache_max_age, &info);
+	settings.use_cache = !settings.cache_directory.empty();
+	// Pacing is shared by every connection of the database, so it follows the global settings only: a session value
+	// would overwrite the pace of the other sessions
+	settings.host_concurrency = sistat::DEFAULT_MAX_CONCURRENCY;
+	TryGetGlobalSetting(db, sistat::MAX_CONCURRENCY_SETTING, settings.host_concurrency);
+	TryGetGlobalSetting(db, sistat::REQUESTS_PER_SECOND_SETTING, settings.requests_per_second);
+	TryGetGlobalSetting(db, sistat::REQUEST_BURST_SETTING, settings.request_burst);
+	FileOpener::TryGetCurrentSetting(&opener, sistat::RETRIES_SETTING, settings.retries, &info);
+	FileOpener::TryGetCurrentSetting(&opener, sistat::RETRY_WAIT_MS_SETTING, settings.retry_wait_ms, &info);
+	FileOpener::TryGetCurrentSetting(&opener, sistat::RETRY_MAX_WAIT_MS_SETTING, settings.retry_max_wait_ms, &info);
 
 	string custom_user_agent;
 	if (FileOpener::TryGetCurrentSetting(&opener, "http_user_agent", custom_user_agent, &info) &&
@@ -114,112 +761,195 @@ HttpSettings HttpRequest::ExtractHttpSettings(ClientContext &context, const stri
 HttpResponseData HttpRequest::ExecuteHttpRequest(const HttpSettings &settings, const string &url, const string &method,
                                                  const duckdb_httplib_openssl::Headers &headers,
                                                  const string &request_body, const string &content_type) {
+	string body;
+	HttpBodyReceiver append = [&](const char *data, idx_t size) {
+		body.append(data, size);
+		return true;
+	};
+	auto result = ExecuteStreamingRequest(settings, url, method, headers, request_body, content_type, append,
+	                                      [&]() { body.clear(); });
+	if (result.status_code == 200) {
+		result.body = std::move(body);
+	}
+	return result;
+}
+
+HttpResponseData HttpRequest::ExecuteStreamingRequest(const HttpSettings &settings, const string &url,
+                                                      const string &method,
+                                                      const duckdb_httplib_openssl::Headers &headers,
+                                                      const string &request_body, const string &content_type,
+                                                      const HttpBodyReceiver &receiver,
+                                                      const HttpBodyRestart &restart) {
 
 	HttpResponseData result;
 	result.status_code = 0;
 	result.content_length = -1;
+	// Raised while decoding or by the receiver; rethrown once the client is cleaned up, as httplib expects its
+	// callbacks not to throw
+	std::exception_ptr receiver_error;
 
 	try {
 		string proto_host_port, path;
 		ParseUrl(url, proto_host_port, path);
-		idx_t max_attempts = DEFAULT_HTTP_RETRY_COUNT;
+		idx_t max_attempts = settings.retries + 1;
 		string last_error;
+		auto pool_ptr = settings.client_pool ? settings.client_pool : make_shared_ptr<HttpClientPool>();
+		auto &pool = *pool_ptr;
+		auto client_key = HttpClientPool::ClientKey(settings, proto_host_port);
+		auto throttles_ptr = settings.throttles ? settings.throttles : make_shared_ptr<HostThrottles>();
+		auto &throttle = throttles_ptr->ForHost(proto_host_port);
+		auto &stats = settings.stats;
+		stats.Add(&SistatStats::requests, 1);
 
 		for (idx_t attempt = 1; attempt <= max_attempts; attempt++) {
-			duckdb_httplib_openssl::Client client(proto_host_port);
-			client.set_follow_location(settings.follow_redirects);
-			client.set_decompress(false);
-			client.enable_server_certificate_verification(settings.enable_server_cert_verification);
-			if (settings.enable_server_cert_verification && !settings.ca_cert_file.empty()) {
-				client.set_ca_cert_path(settings.ca_cert_file);
-			}
-
-			auto timeout_sec = static_cast<time_t>(settings.timeout);
-			client.set_read_timeout(timeout_sec, 0);
-			client.set_write_timeout(timeout_sec, 0);
-			client.set_connection_timeout(timeout_sec, 0);
-			client.set_keep_alive(settings.keep_alive);
-
-			if (!settings.proxy.empty()) {
-				string proxy_host;
-				idx_t proxy_port = 80;
-				string proxy_copy = settings.proxy;
-				HTTPUtil::ParseHTTPProxyHost(proxy_copy, proxy_host, proxy_port);
-				client.set_proxy(proxy_host, static_cast<int>(proxy_port));
-				if (!settings.proxy_username.empty()) {
-					client.set_proxy_basic_auth(settings.proxy_username, settings.proxy_password);
-				}
+			if (attempt > 1) {
+				stats.Add(&SistatStats::retries, 1);
 			}
-
-			duckdb_httplib_openssl::Headers req_headers = headers;
-			if (req_headers.find("User-Agent") == req_headers.end()) {
-				req_headers.insert({"User-Agent", settings.user_agent});
+			auto throttle_start = std::chrono::steady_clock::now();
+			ThrottleSlot slot(throttle, settings);
+			stats.Add(&SistatStats::throttle_wait_us, StatsRecorder::MicrosSince(throttle_start));
+			if (!slot.Held()) {
+				result.error = FormatCancelledError(url, method);
+				return result;
 			}
-
-			duckdb_httplib_openssl::Result res(nullptr, duckdb_httplib_openssl::Error::Unknown);
-
-			if (StringUtil::CIEquals(method, "HEAD")) {
-				res = client.Head(path, req_headers);
-			} else if (StringUtil::CIEquals(method, "DELETE")) {
-				res = client.Delete(path, req_headers);
-			} else if (StringUtil::CIEquals(method, "POST")) {
-				string ct = content_type.empty() ? "application/octet-stream" : content_type;
-				res = client.Post(path, req_headers, request_body, ct);
-			} else if (StringUtil::CIEquals(method, "PUT")) {
-				string ct = content_type.empty() ? "application/octet-stream" : content_type;
-				res = client.Put(path, req_headers, request_body, ct);
-			} else if (StringUtil::CIEquals(method, "PATCH")) {
-				string ct = content_type.empty() ? "application/octet-stream" : content_type;
-				res = client.Patch(path, req_headers, request_body, ct);
-			} else {
-				res = client.Get(path, req_headers);
+			auto client_ptr = pool.Acquire(settings, client_key, proto_host_port);
+			bool reused = client_ptr->is_socket_open() > 0;
+			stats.Add(reused ? &SistatStats::connections_reused : &SistatStats::connections_opened, 1);
+
+			duckdb_httplib_openssl::Request req;
+			req.method = StringUtil::Upper(method);
+			req.path = path;
+			req.headers = headers;
+			if (req.headers.find("User-Agent") == req.headers.end()) {
+				req.headers.insert({"User-Agent", settings.user_agent});
+			}
+			if (req.headers.find("Accept-Encoding") == req.headers.end()) {
+				req.headers.insert({"Accept-Encoding", "gzip, deflate"});
+			}
+			if (req.method == "POST" || req.method == "PUT" || req.method == "PATCH") {
+				req.body = request_body;
+				req.set_header("Content-Type", content_type.empty() ? "application/octet-stream" : content_type);
 			}
 
-			if (res.error() != duckdb_httplib_openssl::Error::Success) {
-				last_error = FormatTransportError(url, method, res.error(), attempt, max_attempts);
-				if (attempt < max_attempts && IsRetryableError(res.error())) {
-					std::this_thread::sleep_for(
-					    std::chrono::milliseconds(DEFAULT_HTTP_RETRY_BACKOFF_MS * static_cast<int64_t>(attempt)));
-					continue;
+			int status = 0;
+			unique_ptr<ContentDecoder> decoder;
+			bool sniffed = false;
+			// Whether part of the body reached the receiver, after which the request can only be retried through
+			// `restart`
+			bool delivered = false;
+			// Decoded body of an unsuccessful response
+			string buffered;
+			// Phase boundaries of this attempt; the socket is only created when no pooled connection is open
+			auto send_start = std::chrono::steady_clock::now();
+			auto socket_created = send_start;
+			auto headers_received = send_start;
+			bool has_headers = false;
+			// Time spent in the body callbacks, which is decompression and decoding rather than transfer
+			uint64_t content_us = 0;
+			uint64_t receiver_us = 0;
+			client_ptr->set_socket_options([&](socket_t) { socket_created = std::chrono::steady_clock::now(); });
+			req.response_handler = [&](const duckdb_httplib_openssl::Response &response) {
+				headers_received = std::chrono::steady_clock::now();
+				has_headers = true;
+				status = response.status;
+				decoder = ContentDecoder::Create(response.get_header_value("Content-Encoding"));
+				return true;
+			};
+			HttpBodyReceiver sink = [&](const char *data, idx_t size) {
+				stats.Add(&SistatStats::body_bytes, size);
+				if (status != 200) {
+					buffered.append(data, size);
+					return true;
 				}
-				result.error = last_error;
+				delivered = true;
+				auto receiver_start = std::chrono::steady_clock::now();
+				auto keep_going = receiver(data, size);
+				receiver_us += StatsRecorder::MicrosSince(receiver_start);
+				return keep_going;
+			};
+			req.content_receiver = [&](const char *data, size_t size, uint64_t, uint64_t) {
+				auto content_start = std::chrono::steady_clock::now();
+				stats.Add(&SistatStats::wire_bytes, size);
+				bool keep_going;
+				try {
+					if (!sniffed) {
+						// Some servers compress without saying so
+						sniffed = true;
+						if (!decoder && GZipFileSystem::CheckIsZip(data, size)) {
+							decoder = ContentDecoder::Create("gzip");
+						}
+					}
+					keep_going = decoder ? decoder->Feed(data, size, sink) : sink(data, size);
+				} catch (...) {
+					receiver_error = std::current_exception();
+					keep_going = false;
+				}
+				content_us += StatsRecorder::MicrosSince(content_start);
+				return keep_going;
+			};
+
+			duckdb_httplib_openssl::Response res;
+			auto error = duckdb_httplib_openssl::Error::Success;
+			{
+				CancellableSend send(settings, *client_ptr);
+				if (!send.Registered()) {
+					result.error = FormatCancelledError(url, method);
+					return result;
+				}
+				client_ptr->send(req, res, error);
+			}
+			client_ptr->set_socket_options(nullptr);
+			RecordPhases(stats, send_start, socket_created, headers_received, has_headers, content_us, receiver_us);
+			if (!receiver_error && error == duckdb_httplib_openssl::Error::Success && status == 200 && decoder) {
+				try {
+					decoder->Finish();
+				} catch (...) {
+					receiver_error = std::current_exception();
+				}
+			}
+			if (receiver_error) {
+				break;
+			}
+			if (IsCancelled(settings)) {
+				// The connection may have been shut down mid-transfer, so the client is not pooled
+				result.error = FormatCancelledError(url, method);
 				return result;
 			}
-
-			result.status_code = res->status;
-			string response_body = res->body;
-
-			for (auto &header : res->headers) {
-				string normalized_key = NormalizeHeaderName(header.first);
-				if (StringUtil::CIEquals(header.first, "Content-Type")) {
-					result.content_type = header.second;
-				} else if (StringUtil::CIEquals(header.first, "Content-Length")) {
-					try {
-						result.content_length = std::stoll(header.second);
-					} catch (...) {
+			if (error != duckdb_httplib_openssl::Error::Success) {
+				// The client is dropped rather than pooled: its connection is in an unknown state
+				last_error = FormatTransportError(url, method, error, attempt, max_attempts);
+				if ((!delivered || restart) && attempt < max_attempts && IsRetryableError(error)) {
+					if (delivered) {
+						restart();
 					}
-				}
-				bool found = false;
-				for (idx_t i = 0; i < result.header_keys.size(); i++) {
-					if (StringUtil::CIEquals(result.header_keys[i].GetValue<string>(), normalized_key)) {
-						result.header_values[i] = Value(header.second);
-						found = true;
-						break;
+					slot.Release(false);
+					if (!SleepUnlessCancelled(settings, std::chrono::milliseconds(BackoffMs(settings, attempt, 0)))) {
+						result.error = FormatCancelledError(url, method);
+						return result;
 					}
+					continue;
 				}
-				if (!found) {
-					result.header_keys.push_back(Value(normalized_key));
-					result.header_values.push_back(Value(header.second));
-				}
+				result.error = last_error;
+				return result;
 			}
-
-			result.body = response_body;
-			try {
-				if (GZipFileSystem::CheckIsZip(response_body.data(), response_body.size())) {
-					result.body = GZipFileSystem::UncompressGZIPString(response_body);
+			slot.Release(IsThrottledStatus(res.status));
+
+			if (attempt < max_attempts && IsRetryableStatus(res.status)) {
+				last_error = StringUtil::Format("HTTP %d for %s %s [attempt %d/%d]", res.status, method, url,
+				                                static_cast<int>(attempt), static_cast<int>(max_attempts));
+				auto backoff_ms = BackoffMs(settings, attempt, RetryAfterMs(res));
+				pool.Release(settings, client_key, std::move(client_ptr));
+				if (!SleepUnlessCancelled(settings, std::chrono::milliseconds(backoff_ms))) {
+					result.error = FormatCancelledError(url, method);
+					return result;
 				}
-			} catch (...) {
+				continue;
 			}
+
+			result.status_code = res.status;
+			result.body = std::move(buffered);
+			CollectHeaders(res.headers, result);
+			pool.Release(settings, client_key, std::move(client_ptr));
 			return result;
 		}
 
@@ -231,6 +961,9 @@ HttpResponseData HttpRequest::ExecuteHttpRequest(const HttpSettings &settings, c
 		result.error = e.what();
 	}
 
+	if (receiver_error) {
+		std::rethrow_exception(receiver_error);
+	}
 	return result;
 }
 
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "duckdb.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "sistat_stats.hpp"
+
+#include <condition_variable>
 
 // Use httplib directly for full HTTP method support
 #define CPPHTTPLIB_OPENSSL_SUPPORT
@@ -13,6 +18,31 @@ namespace duckdb {
 // 	https://github.com/midwork-finds-jobs/duckdb_http_request
 // 	Thanks a lot to Onni Hakala (onnimonni) for open sourcing it!
 
+class HttpClientPool;
+class HostThrottles;
+
+//! Stops the requests of a call from another thread, for example when a scan ends early: waits for request pacing
+//! and retry backoff end at once, no further attempt is made, and the connection of a transfer in progress is shut
+//! down instead of being left to run into its timeout
+class HttpCancellation {
+public:
+	void Cancel();
+	bool IsCancelled() const {
+		return cancelled;
+	}
+	//! Sleep for `duration` unless cancelled first; false when cancelled
+	bool Sleep(std::chrono::microseconds duration);
+	//! Track the client of an attempt in progress, so Cancel can shut its connection down; false when cancelled
+	bool AddClient(duckdb_httplib_openssl::Client &client);
+	void RemoveClient(duckdb_httplib_openssl::Client &client);
+
+private:
+	mutex lock;
+	std::condition_variable cancelled_cv;
+	atomic<bool> cancelled {false};
+	unordered_set<duckdb_httplib_openssl::Client *> clients;
+};
+
 //! Struct to hold HTTP settings extracted from context (thread-safe to pass to workers)
 struct HttpSettings {
 	uint64_t timeout;
@@ -26,6 +56,26 @@ struct HttpSettings {
 	uint64_t max_concurrency;
 	bool use_cache;
 	bool follow_redirects;
+	//! On-disk response cache (see ResponseCache); only used when `use_cache` is set
+	string cache_directory;
+	uint64_t cache_max_size;
+	uint64_t cache_max_age;
+	//! Request pacing per host (see HostThrottle), taken from the global settings because every connection of the
+	//! database shares it; a rate of 0 disables the token bucket
+	shared_ptr<HostThrottles> throttles;
+	double requests_per_second;
+	uint64_t request_burst;
+	uint64_t host_concurrency;
+	//! Retries after the first attempt, with capped exponential backoff and full jitter
+	uint64_t retries;
+	uint64_t retry_wait_ms;
+	uint64_t retry_max_wait_ms;
+	//! Counters of the calling function and its database; requests record their phases here
+	StatsRecorder stats;
+	//! Idle keep-alive clients of the database; requests without one use a private pool
+	shared_ptr<HttpClientPool> client_pool;
+	//! Set when the caller may stop its requests from another thread
+	shared_ptr<HttpCancellation> cancellation;
 };
 
 //! Struct to hold HTTP response
@@ -40,6 +90,11 @@ struct HttpResponseData {
 	string error; // Non-empty if request failed
 };
 
+//! Receives a response body piece by piece as it arrives; returning false aborts the transfer
+typedef std::function<bool(const char *data, idx_t size)> HttpBodyReceiver;
+//! Discards the body a failed attempt delivered, so the request can be retried from the start
+typedef std::function<void()> HttpBodyRestart;
+
 //! Represents an HTTP request
 struct HttpRequest {
 
@@ -50,6 +105,17 @@ struct HttpRequest {
 	static HttpResponseData ExecuteHttpRequest(const HttpSettings &settings, const string &url, const string &method,
 	                                           const duckdb_httplib_openssl::Headers &headers,
 	                                           const string &request_body, const string &content_type);
+
+	// Execute HTTP request, handing the body of a successful (200) response to `receiver` while it downloads instead
+	// of buffering it. Other responses are returned with their body as usual. Exceptions raised by the receiver are
+	// rethrown. A transfer that breaks off after part of the body was delivered is only retried when `restart` is
+	// given, which is called first.
+	static HttpResponseData ExecuteStreamingRequest(const HttpSettings &settings, const string &url,
+	                                                const string &method,
+	                                                const duckdb_httplib_openssl::Headers &headers,
+	                                                const string &request_body, const string &content_type,
+	                                                const HttpBodyReceiver &receiver,
+	                                                const HttpBodyRestart &restart = nullptr);
 };
 
 } // namespace duckdb
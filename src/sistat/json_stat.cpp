@@ -0,0 +1,394 @@
+#include "json_stat.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/types/load_store.hpp"
+#include "yyjson.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+
+using duckdb_yyjson::yyjson_arr_size;
+using duckdb_yyjson::yyjson_doc;
+using duckdb_yyjson::yyjson_doc_free;
+using duckdb_yyjson::yyjson_doc_get_root;
+using duckdb_yyjson::yyjson_equals_str;
+using duckdb_yyjson::yyjson_get_num;
+using duckdb_yyjson::yyjson_get_str;
+using duckdb_yyjson::yyjson_get_uint;
+using duckdb_yyjson::yyjson_is_arr;
+using duckdb_yyjson::yyjson_is_num;
+using duckdb_yyjson::yyjson_is_obj;
+using duckdb_yyjson::yyjson_is_str;
+using duckdb_yyjson::yyjson_is_uint;
+using duckdb_yyjson::yyjson_obj_get;
+using duckdb_yyjson::yyjson_alc;
+using duckdb_yyjson::yyjson_read_opts;
+using duckdb_yyjson::yyjson_val;
+
+namespace duckdb {
+
+optional_idx JsonStatCube::FindDimension(const string &id) const {
+	for (idx_t d = 0; d < dimension_ids.size(); d++) {
+		if (dimension_ids[d] == id) {
+			return d;
+		}
+	}
+	return optional_idx();
+}
+
+bool JsonStat::IsStatisticalSymbol(const string &s) {
+	return s == "-" || s == "..." || s == "z" || s == "M" || s == "N";
+}
+
+uint8_t JsonStatCube::StatusId(const string &status) {
+	for (idx_t i = 0; i < statuses.size(); i++) {
+		if (statuses[i] == status) {
+			return static_cast<uint8_t>(i + 1);
+		}
+	}
+	if (statuses.size() >= NumericLimits<uint8_t>::Maximum()) {
+		throw IOException("JSON-stat: too many distinct status symbols");
+	}
+	statuses.push_back(status);
+	return static_cast<uint8_t>(statuses.size());
+}
+
+JsonStatCube &JsonStatCube::operator=(JsonStatCube &&other) noexcept {
+	dimension_ids = std::move(other.dimension_ids);
+	codes_per_dim = std::move(other.codes_per_dim);
+	strides = std::move(other.strides);
+	statuses = std::move(other.statuses);
+	value_data = std::move(other.value_data);
+	status_data = std::move(other.status_data);
+	values = other.values;
+	status_ids = other.status_ids;
+	cell_count = other.cell_count;
+	other.values = nullptr;
+	other.status_ids = nullptr;
+	other.cell_count = 0;
+	return *this;
+}
+
+void JsonStatCube::Initialize(Allocator &allocator, vector<string> dimension_ids_p,
+                              vector<vector<string>> codes_per_dim_p) {
+	dimension_ids = std::move(dimension_ids_p);
+	codes_per_dim = std::move(codes_per_dim_p);
+	idx_t num_dim = dimension_ids.size();
+	idx_t total_cells = num_dim == 0 ? 0 : 1;
+	strides.resize(num_dim);
+	for (idx_t d = num_dim; d > 0; d--) {
+		strides[d - 1] = total_cells;
+		total_cells *= codes_per_dim[d - 1].size();
+	}
+	value_data.Reset();
+	status_data.Reset();
+	values = nullptr;
+	status_ids = nullptr;
+	cell_count = 0;
+	if (total_cells > 0) {
+		value_data = allocator.Allocate(total_cells * sizeof(double));
+		status_data = allocator.Allocate(total_cells * sizeof(uint8_t));
+		values = reinterpret_cast<double *>(value_data.get());
+		status_ids = reinterpret_cast<uint8_t *>(status_data.get());
+		cell_count = total_cells;
+	}
+	std::fill(values, values + total_cells, std::numeric_limits<double>::quiet_NaN());
+	std::fill(status_ids, status_ids + total_cells, static_cast<uint8_t>(0));
+	statuses.clear();
+}
+
+void JsonStatCube::Merge(const JsonStatCube &part) {
+	idx_t num_dim = part.dimension_ids.size();
+	// Offset in this cube of every position of every dimension of the part
+	vector<vector<idx_t>> offsets(num_dim);
+	for (idx_t d = 0; d < num_dim; d++) {
+		auto dim = FindDimension(part.dimension_ids[d]);
+		if (!dim.IsValid()) {
+			throw IOException("JSON-stat: unexpected dimension %s in partial response", part.dimension_ids[d]);
+		}
+		auto &codes = codes_per_dim[dim.GetIndex()];
+		for (auto &code : part.codes_per_dim[d]) {
+			auto it = std::find(codes.begin(), codes.end(), code);
+			if (it == codes.end()) {
+				throw IOException("JSON-stat: unexpected code %s of dimension %s in partial response", code,
+				                  part.dimension_ids[d]);
+			}
+			offsets[d].push_back(static_cast<idx_t>(it - codes.begin()) * strides[dim.GetIndex()]);
+		}
+	}
+	vector<uint8_t> status_map(part.statuses.size() + 1, 0);
+	for (idx_t i = 0; i < part.statuses.size(); i++) {
+		status_map[i + 1] = StatusId(part.statuses[i]);
+	}
+
+	// Walk the part in its own row-major order, keeping a position counter per dimension
+	vector<idx_t> position(num_dim, 0);
+	for (idx_t cell = 0; cell < part.CellCount(); cell++) {
+		idx_t target = 0;
+		for (idx_t d = 0; d < num_dim; d++) {
+			target += offsets[d][position[d]];
+		}
+		values[target] = part.values[cell];
+		status_ids[target] = status_map[part.status_ids[cell]];
+		for (idx_t d = num_dim; d > 0; d--) {
+			if (++position[d - 1] < offsets[d - 1].size()) {
+				break;
+			}
+			position[d - 1] = 0;
+		}
+	}
+}
+
+static void SetCell(JsonStatCube &cube, idx_t cell, yyjson_val *val) {
+	if (yyjson_is_num(val)) {
+		cube.values[cell] = yyjson_get_num(val);
+		return;
+	}
+	if (!yyjson_is_str(val)) {
+		return;
+	}
+	// Some responses inline symbols or numbers as strings
+	string text = yyjson_get_str(val);
+	double number;
+	if (text.empty()) {
+		return;
+	}
+	string_t text_value(text.c_str(), static_cast<uint32_t>(text.size()));
+	if (!JsonStat::IsStatisticalSymbol(text) && TryCast::Operation<string_t, double>(text_value, number, true)) {
+		cube.values[cell] = number;
+		return;
+	}
+	cube.status_ids[cell] = cube.StatusId(text);
+}
+
+static void SetStatus(JsonStatCube &cube, idx_t cell, yyjson_val *val) {
+	if (cell < cube.CellCount() && yyjson_is_str(val)) {
+		cube.status_ids[cell] = cube.StatusId(yyjson_get_str(val));
+	}
+}
+
+namespace {
+
+//! yyjson allocator drawing from a DuckDB allocator. yyjson frees without a size, so every block is prefixed with its
+//! own; allocation failures are kept and rethrown once yyjson has cleaned up.
+struct JsonAllocator {
+	static constexpr idx_t HEADER_SIZE = 16;
+
+	explicit JsonAllocator(Allocator &allocator_p) : allocator(allocator_p) {
+		alc.malloc = Malloc;
+		alc.realloc = Realloc;
+		alc.free = Free;
+		alc.ctx = this;
+	}
+
+	static void *Malloc(void *ctx, size_t size) {
+		return Realloc(ctx, nullptr, 0, size);
+	}
+
+	static void *Realloc(void *ctx, void *ptr, size_t old_size, size_t size) {
+		auto &self = *static_cast<JsonAllocator *>(ctx);
+		try {
+			data_ptr_t block;
+			if (ptr) {
+				auto old_block = static_cast<data_ptr_t>(ptr) - HEADER_SIZE;
+				block = self.allocator.ReallocateData(old_block, old_size + HEADER_SIZE, size + HEADER_SIZE);
+			} else {
+				block = self.allocator.AllocateData(size + HEADER_SIZE);
+			}
+			Store<idx_t>(size, block);
+			return block + HEADER_SIZE;
+		} catch (...) {
+			self.error = std::current_exception();
+			return nullptr;
+		}
+	}
+
+	static void Free(void *ctx, void *ptr) {
+		if (!ptr) {
+			return;
+		}
+		auto &self = *static_cast<JsonAllocator *>(ctx);
+		auto block = static_cast<data_ptr_t>(ptr) - HEADER_SIZE;
+		self.allocator.FreeData(block, Load<idx_t>(block) + HEADER_SIZE);
+	}
+
+	Allocator &allocator;
+	yyjson_alc alc;
+	std::exception_ptr error;
+};
+
+} // namespace
+
+JsonStatCube JsonStat::Parse(const char *data, idx_t size, Allocator &allocator, uint64_t *parse_micros) {
+	JsonAllocator json_allocator(allocator);
+	auto parse_start = std::chrono::steady_clock::now();
+	// Without YYJSON_READ_INSITU the input is only read
+	yyjson_doc *doc = yyjson_read_opts(const_cast<char *>(data), size, 0, &json_allocator.alc, nullptr);
+	if (parse_micros) {
+		auto elapsed = std::chrono::steady_clock::now() - parse_start;
+		*parse_micros = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+	}
+	if (!doc) {
+		if (json_allocator.error) {
+			std::rethrow_exception(json_allocator.error);
+		}
+		throw IOException("JSON-stat: invalid response");
+	}
+
+	yyjson_val *root = yyjson_doc_get_root(doc);
+	yyjson_val *dataset = yyjson_is_obj(root) ? yyjson_obj_get(root, "dataset") : nullptr;
+	if (!yyjson_is_obj(dataset) && yyjson_is_obj(root) && yyjson_equals_str(yyjson_obj_get(root, "class"), "dataset")) {
+		// json-stat 2.0: the dataset is the root object
+		dataset = root;
+	}
+	if (!yyjson_is_obj(dataset)) {
+		yyjson_doc_free(doc);
+		throw IOException("JSON-stat: expected root object with 'dataset'");
+	}
+
+	yyjson_val *dim = yyjson_obj_get(dataset, "dimension");
+	if (!yyjson_is_obj(dim)) {
+		yyjson_doc_free(doc);
+		throw IOException("JSON-stat: dataset.dimension missing");
+	}
+
+	// json-stat 1.0 keeps id and size inside the dimension object, 2.0 on the dataset
+	yyjson_val *id_arr = yyjson_obj_get(dim, "id");
+	if (!yyjson_is_arr(id_arr)) {
+		id_arr = yyjson_obj_get(dataset, "id");
+	}
+	if (!yyjson_is_arr(id_arr)) {
+		yyjson_doc_free(doc);
+		throw IOException("JSON-stat: dataset.dimension.id must be array");
+	}
+
+	yyjson_val *size_arr = yyjson_obj_get(dim, "size");
+	if (!yyjson_is_arr(size_arr)) {
+		size_arr = yyjson_obj_get(dataset, "size");
+	}
+	if (!yyjson_is_arr(size_arr)) {
+		yyjson_doc_free(doc);
+		throw IOException("JSON-stat: dataset.dimension.size must be array");
+	}
+
+	size_t num_dim = yyjson_arr_size(id_arr);
+	if (yyjson_arr_size(size_arr) != num_dim) {
+		yyjson_doc_free(doc);
+		throw IOException("JSON-stat: dimension id/size length mismatch");
+	}
+
+	vector<string> dimension_ids;
+	vector<idx_t> sizes;
+	size_t iter_idx, iter_max;
+	yyjson_val *item = nullptr;
+	yyjson_arr_foreach(id_arr, iter_idx, iter_max, item) {
+		dimension_ids.emplace_back(yyjson_is_str(item) ? yyjson_get_str(item) : "");
+	}
+	yyjson_arr_foreach(size_arr, iter_idx, iter_max, item) {
+		sizes.push_back(yyjson_is_uint(item) ? yyjson_get_uint(item) : 0);
+	}
+
+	vector<vector<string>> codes_per_dim(num_dim);
+	for (size_t d = 0; d < num_dim; d++) {
+		auto &dim_id = dimension_ids[d];
+		yyjson_val *dim_obj = yyjson_obj_get(dim, dim_id.c_str());
+		if (!yyjson_is_obj(dim_obj)) {
+			yyjson_doc_free(doc);
+			throw IOException("JSON-stat: dimension.%s missing", dim_id.c_str());
+		}
+		yyjson_val *cat = yyjson_obj_get(dim_obj, "category");
+		if (!yyjson_is_obj(cat)) {
+			yyjson_doc_free(doc);
+			throw IOException("JSON-stat: dimension.%s.category missing", dim_id.c_str());
+		}
+		yyjson_val *index_obj = yyjson_obj_get(cat, "index");
+		vector<string> codes(sizes[d]);
+		if (yyjson_is_arr(index_obj)) {
+			// json-stat 2.0 may list the codes in order instead of mapping them to positions
+			yyjson_arr_foreach(index_obj, iter_idx, iter_max, item) {
+				if (iter_idx < codes.size() && yyjson_is_str(item)) {
+					codes[iter_idx] = yyjson_get_str(item);
+				}
+			}
+		} else if (yyjson_is_obj(index_obj)) {
+			yyjson_val *key = nullptr;
+			yyjson_val *val = nullptr;
+			yyjson_obj_foreach(index_obj, iter_idx, iter_max, key, val) {
+				if (yyjson_is_str(key) && yyjson_is_uint(val)) {
+					size_t pos = yyjson_get_uint(val);
+					if (pos < codes.size()) {
+						codes[pos] = yyjson_get_str(key);
+					}
+				}
+			}
+		} else if (sizes[d] == 1 && yyjson_is_obj(yyjson_obj_get(cat, "label"))) {
+			// A single category may come with a label only
+			yyjson_val *key = nullptr;
+			yyjson_val *val = nullptr;
+			yyjson_obj_foreach(yyjson_obj_get(cat, "label"), iter_idx, iter_max, key, val) {
+				codes[0] = yyjson_get_str(key);
+				break;
+			}
+		} else {
+			yyjson_doc_free(doc);
+			throw IOException("JSON-stat: dimension.%s.category.index missing", dim_id.c_str());
+		}
+		codes_per_dim[d] = std::move(codes);
+	}
+
+	yyjson_val *value_arr = yyjson_obj_get(dataset, "value");
+	if (!yyjson_is_arr(value_arr) && !yyjson_is_obj(value_arr)) {
+		yyjson_doc_free(doc);
+		throw IOException("JSON-stat: dataset.value must be array or object");
+	}
+
+	JsonStatCube cube;
+	// Cells are decoded after the cube is allocated; the document must be freed however that ends
+	try {
+		cube.Initialize(allocator, std::move(dimension_ids), std::move(codes_per_dim));
+		idx_t total_cells = cube.CellCount();
+
+		// Iterate sequentially: positional access into a yyjson array is linear, which made the walk quadratic
+		if (yyjson_is_arr(value_arr)) {
+			yyjson_arr_foreach(value_arr, iter_idx, iter_max, item) {
+				if (iter_idx >= total_cells) {
+					break;
+				}
+				SetCell(cube, iter_idx, item);
+			}
+		} else {
+			yyjson_val *key = nullptr;
+			yyjson_obj_foreach(value_arr, iter_idx, iter_max, key, item) {
+				auto cell = std::strtoull(yyjson_get_str(key), nullptr, 10);
+				if (cell < total_cells) {
+					SetCell(cube, cell, item);
+				}
+			}
+		}
+
+		// Status is either a single symbol for all cells, an array parallel to the values or a sparse object
+		yyjson_val *status = yyjson_obj_get(dataset, "status");
+		if (yyjson_is_str(status)) {
+			for (idx_t cell = 0; cell < total_cells; cell++) {
+				SetStatus(cube, cell, status);
+			}
+		} else if (yyjson_is_arr(status)) {
+			yyjson_arr_foreach(status, iter_idx, iter_max, item) {
+				SetStatus(cube, iter_idx, item);
+			}
+		} else if (yyjson_is_obj(status)) {
+			yyjson_val *key = nullptr;
+			yyjson_obj_foreach(status, iter_idx, iter_max, key, item) {
+				SetStatus(cube, std::strtoull(yyjson_get_str(key), nullptr, 10), item);
+			}
+		}
+	} catch (...) {
+		yyjson_doc_free(doc);
+		throw;
+	}
+	yyjson_doc_free(doc);
+	return cube;
+}
+
+} // namespace duckdb
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/allocator.hpp"
+
+#include <cmath>
+
+namespace duckdb {
+
+//! A decoded JSON-stat dataset. Cells are kept in row-major order (the last dimension varies fastest), so the
+//! dimension codes of a cell are derived from its flat index instead of being stored per cell. The cell arrays are
+//! drawn from the allocator passed to Initialize, normally the buffer allocator, so they count against memory_limit.
+struct JsonStatCube {
+	JsonStatCube() = default;
+	JsonStatCube(JsonStatCube &&other) noexcept {
+		*this = std::move(other);
+	}
+	JsonStatCube &operator=(JsonStatCube &&other) noexcept;
+
+	//! Dimension ids (variable codes) in cube order
+	vector<string> dimension_ids;
+	//! Category codes of each dimension, by position
+	vector<vector<string>> codes_per_dim;
+	//! Flat index distance between consecutive positions of each dimension
+	vector<idx_t> strides;
+	//! Numeric cell values; NaN marks a missing value
+	double *values = nullptr;
+	//! 0 for cells without a status, otherwise 1 + index into `statuses`
+	uint8_t *status_ids = nullptr;
+	//! Distinct status symbols ("-", "...", "z", ...) found in the response
+	vector<string> statuses;
+
+	idx_t CellCount() const {
+		return cell_count;
+	}
+	//! Position of a cell along a dimension
+	idx_t CodeIndex(idx_t dim, idx_t cell) const {
+		return (cell / strides[dim]) % codes_per_dim[dim].size();
+	}
+	bool HasValue(idx_t cell) const {
+		return !std::isnan(values[cell]);
+	}
+	optional_idx FindDimension(const string &id) const;
+	//! Set up an all-missing cube with the given dimensions
+	void Initialize(Allocator &allocator, vector<string> dimension_ids, vector<vector<string>> codes_per_dim);
+	//! Copy the cells of a sub-cube into their positions in this cube, matching dimensions and codes by name
+	void Merge(const JsonStatCube &part);
+	//! Status id for a symbol, registering it if it was not seen before
+	uint8_t StatusId(const string &status);
+
+private:
+	idx_t cell_count = 0;
+	AllocatedData value_data;
+	AllocatedData status_data;
+};
+
+struct JsonStat {
+	//! Parse a json-stat response (version 1.0 or 2.0) as returned by PxWeb. The document and the cube are both
+	//! allocated from `allocator`. When given, `parse_micros` receives the time yyjson took to parse the document,
+	//! as opposed to extracting the cells from it.
+	static JsonStatCube Parse(const char *data, idx_t size, Allocator &allocator, uint64_t *parse_micros = nullptr);
+	//! Whether a cell string is one of the statistical symbols used instead of a value
+	static bool IsStatisticalSymbol(const string &s);
+};
+
+} // namespace duckdb
@@ -0,0 +1,135 @@
+#include "metadata_cache.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "sistat.hpp"
+#include "mirror.hpp"
+#include "response_cache.hpp"
+
+namespace duckdb {
+
+static string FetchTableMetadata(const HttpSettings &settings, const string &table_url, const string &function_name) {
+	HttpResponseData resp = ResponseCache::ExecuteRequest(settings, table_url, "GET", {}, "", "");
+
+	if (!resp.error.empty()) {
+		throw IOException("%s: %s", function_name, resp.error);
+	}
+	if (resp.status_code != 200) {
+		throw IOException("%s: HTTP %d - %s", function_name, resp.status_code, resp.body);
+	}
+	return std::move(resp.body);
+}
+
+template <class T>
+static T GetSetting(ClientContext &context, const char *name, T default_value) {
+	Value setting;
+	if (context.TryGetCurrentSetting(name, setting) && !setting.IsNull()) {
+		return setting.GetValue<T>();
+	}
+	return default_value;
+}
+
+optional_idx MetadataCache::GetEstimatedCacheMemory() const {
+	lock_guard<mutex> guard(lock);
+	idx_t size = 0;
+	for (auto &entry : entries) {
+		size += entry.first.size() + entry.second.body.size();
+	}
+	return size;
+}
+
+bool MetadataCache::TryGet(const string &table_url, std::chrono::seconds ttl, string &body) {
+	lock_guard<mutex> guard(lock);
+	auto entry = entries.find(table_url);
+	if (entry == entries.end()) {
+		return false;
+	}
+	if (std::chrono::steady_clock::now() - entry->second.fetched_at >= ttl) {
+		entries.erase(entry);
+		return false;
+	}
+	entry->second.last_used = ++use_counter;
+	body = entry->second.body;
+	return true;
+}
+
+void MetadataCache::Put(const string &table_url, string body, idx_t max_entries) {
+	lock_guard<mutex> guard(lock);
+	entries.erase(table_url);
+	while (!entries.empty() && entries.size() >= max_entries) {
+		auto oldest = entries.begin();
+		for (auto it = entries.begin(); it != entries.end(); it++) {
+			if (it->second.last_used < oldest->second.last_used) {
+				oldest = it;
+			}
+		}
+		entries.erase(oldest);
+	}
+	entries[table_url] = Entry {std::move(body), std::chrono::steady_clock::now(), ++use_counter};
+}
+
+MetadataCache::Lookup MetadataCache::CreateLookup(ClientContext &context, const string &url) {
+	Lookup lookup;
+	lookup.settings = HttpRequest::ExtractHttpSettings(context, url);
+	lookup.mirror_directory = SistatMirror::Directory(context);
+	lookup.ttl = TimeToLive(context);
+	lookup.max_entries = GetSetting<uint64_t>(context, sistat::METADATA_CACHE_MAX_ENTRIES_SETTING,
+	                                          sistat::DEFAULT_METADATA_CACHE_ENTRIES);
+	if (lookup.ttl.count() > 0 && lookup.max_entries > 0) {
+		lookup.cache = ObjectCache::GetObjectCache(context).GetOrCreate<MetadataCache>(ObjectType());
+	}
+	return lookup;
+}
+
+std::chrono::seconds MetadataCache::TimeToLive(ClientContext &context) {
+	if (!GetSetting<bool>(context, sistat::METADATA_CACHE_SETTING, true)) {
+		return std::chrono::seconds(0);
+	}
+	auto ttl = GetSetting<uint64_t>(context, sistat::METADATA_CACHE_TTL_SETTING, sistat::DEFAULT_METADATA_CACHE_TTL);
+	return std::chrono::seconds(ttl);
+}
+
+string MetadataCache::Lookup::Get(const string &table_url, const string &function_name) const {
+	string body;
+	if (SistatMirror::TryReadMetadata(mirror_directory, table_url, body)) {
+		return body;
+	}
+	if (!cache) {
+		return FetchTableMetadata(settings, table_url, function_name);
+	}
+	if (cache->TryGet(table_url, ttl, body)) {
+		settings.stats.Add(&SistatStats::metadata_cache_hits, 1);
+		return body;
+	}
+	settings.stats.Add(&SistatStats::metadata_cache_misses, 1);
+	// Fetched outside the lock: concurrent misses for the same table may both hit the network, which is harmless
+	body = FetchTableMetadata(settings, table_url, function_name);
+	cache->Put(table_url, body, max_entries);
+	return body;
+}
+
+bool MetadataCache::Lookup::TryGetLocal(const string &table_url, string &body) const {
+	if (SistatMirror::TryReadMetadata(mirror_directory, table_url, body)) {
+		return true;
+	}
+	if (!cache || !cache->TryGet(table_url, ttl, body)) {
+		return false;
+	}
+	settings.stats.Add(&SistatStats::metadata_cache_hits, 1);
+	return true;
+}
+
+string MetadataCache::GetTableMetadata(ClientContext &context, const string &table_url, const string &function_name) {
+	return CreateLookup(context, table_url).Get(table_url, function_name);
+}
+
+idx_t MetadataCache::Clear(ClientContext &context) {
+	auto cache = ObjectCache::GetObjectCache(context).Get<MetadataCache>(ObjectType());
+	if (!cache) {
+		return 0;
+	}
+	lock_guard<mutex> guard(cache->lock);
+	idx_t count = cache->entries.size();
+	cache->entries.clear();
+	return count;
+}
+
+} // namespace duckdb
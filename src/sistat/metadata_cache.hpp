@@ -0,0 +1,64 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "http_request.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+//! Table metadata (the JSON returned by a GET on the table URL), shared by every connection of a database.
+//! Entries expire after `sistat_metadata_cache_ttl` seconds; the least recently used entry is evicted once
+//! `sistat_metadata_cache_max_entries` is reached.
+class MetadataCache : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "sistat_metadata_cache";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	optional_idx GetEstimatedCacheMemory() const override;
+
+	//! Settings and cache resolved on the client thread, so that lookups can run on worker threads
+	struct Lookup {
+		HttpSettings settings;
+		//! Null when caching is disabled
+		shared_ptr<MetadataCache> cache;
+		std::chrono::seconds ttl {0};
+		idx_t max_entries = 0;
+		//! Mirror directory whose metadata snapshots are used before the cache and the server; empty when unset
+		string mirror_directory;
+
+		//! Metadata JSON of the table at `table_url`; errors are reported with `function_name` as prefix
+		string Get(const string &table_url, const string &function_name) const;
+		//! Metadata of the table from its mirror snapshot or the cache, without a request; false when neither has it
+		bool TryGetLocal(const string &table_url, string &body) const;
+	};
+	static Lookup CreateLookup(ClientContext &context, const string &url);
+	//! How long cached metadata stays valid; 0 when the cache is disabled
+	static std::chrono::seconds TimeToLive(ClientContext &context);
+
+	static string GetTableMetadata(ClientContext &context, const string &table_url, const string &function_name);
+	//! Drop every cached entry, returning how many there were
+	static idx_t Clear(ClientContext &context);
+
+private:
+	struct Entry {
+		string body;
+		std::chrono::steady_clock::time_point fetched_at;
+		idx_t last_used;
+	};
+
+	bool TryGet(const string &table_url, std::chrono::seconds ttl, string &body);
+	void Put(const string &table_url, string body, idx_t max_entries);
+
+	mutable mutex lock;
+	unordered_map<string, Entry> entries;
+	idx_t use_counter = 0;
+};
+
+} // namespace duckdb
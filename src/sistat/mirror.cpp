@@ -0,0 +1,67 @@
+#include "mirror.hpp"
+#include "response_cache.hpp"
+#include "sistat.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+//! File name stem of a table, e.g. 05C1002S.px in English -> 05C1002S_en
+static string FileStem(const string &table_id, const string &lang) {
+	auto name = StringUtil::EndsWith(StringUtil::Lower(table_id), ".px") ? table_id.substr(0, table_id.size() - 3)
+	                                                                      : table_id;
+	return name + "_" + lang;
+}
+
+string SistatMirror::Directory(ClientContext &context) {
+	Value setting;
+	if (context.TryGetCurrentSetting(sistat::MIRROR_DIRECTORY_SETTING, setting) && !setting.IsNull()) {
+		return setting.ToString();
+	}
+	return string();
+}
+
+string SistatMirror::DataPath(FileSystem &fs, const string &directory, const string &table_id, const string &lang) {
+	return fs.JoinPath(directory, FileStem(table_id, lang) + ".parquet");
+}
+
+string SistatMirror::MetadataPath(FileSystem &fs, const string &directory, const string &table_id,
+                                  const string &lang) {
+	return fs.JoinPath(directory, FileStem(table_id, lang) + ".json");
+}
+
+bool SistatMirror::TryReadMetadata(const string &directory, const string &table_url, string &metadata) {
+	if (directory.empty()) {
+		return false;
+	}
+	// Table URLs end in <lang>/Data/<table_id>
+	auto parts = StringUtil::Split(table_url, '/');
+	if (parts.size() < 3 || parts[parts.size() - 2] + "/" != sistat::DATA_PATH) {
+		return false;
+	}
+	auto fs = FileSystem::CreateLocal();
+	auto path = MetadataPath(*fs, directory, parts.back(), parts[parts.size() - 3]);
+	auto handle = fs->OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+	if (!handle) {
+		return false;
+	}
+	auto size = handle->GetFileSize();
+	metadata.assign(size, '\0');
+	handle->Read(&metadata[0], size);
+	return true;
+}
+
+void SistatMirror::WriteFile(FileSystem &fs, const string &path, string contents) {
+	RandomEngine random;
+	auto temp_path = StringUtil::Format("%s.%08x.tmp", path, random.NextRandomInteger());
+	{
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(&contents[0], contents.size());
+		handle->Sync();
+		handle->Close();
+	}
+	ResponseCache::ReplaceFile(fs, temp_path, path);
+}
+
+} // namespace duckdb
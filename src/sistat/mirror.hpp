@@ -0,0 +1,24 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/file_system.hpp"
+
+namespace duckdb {
+
+//! Local snapshots written by SISTAT_Mirror into `sistat_mirror_directory`: per table and language a Parquet file
+//! with the rows SISTAT_Read returns, and the table metadata as JSON. While the directory is set, SISTAT_Read scans a
+//! table's snapshot instead of downloading it and metadata lookups read the mirrored JSON; tables without a snapshot
+//! are still fetched from the server.
+struct SistatMirror {
+	//! The configured directory; empty when no mirror is used
+	static string Directory(ClientContext &context);
+	//! Snapshot files of a (normalized) table id, e.g. <directory>/05C1002S_en.parquet
+	static string DataPath(FileSystem &fs, const string &directory, const string &table_id, const string &lang);
+	static string MetadataPath(FileSystem &fs, const string &directory, const string &table_id, const string &lang);
+	//! Mirrored metadata of the table at `table_url`; false when the mirror has none
+	static bool TryReadMetadata(const string &directory, const string &table_url, string &metadata);
+	//! Write a file under a temporary name and rename it into place, so readers never see a partial snapshot
+	static void WriteFile(FileSystem &fs, const string &path, string contents);
+};
+
+} // namespace duckdb
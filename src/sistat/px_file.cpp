@@ -0,0 +1,449 @@
+#include "px_file.hpp"
+#include "duckdb/common/operator/cast_operators.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+
+#include <algorithm>
+
+namespace duckdb {
+
+static bool IsPxSpace(char c) {
+	return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+namespace {
+
+//! One `KEYWORD[lang]("subkey")=value;` entry of the header
+struct PxKeyword {
+	string name;
+	string language;
+	string subkey;
+	vector<string> values;
+};
+
+//! Sequential reader over a PX header, keyword by keyword up to DATA (which per the format is the last keyword)
+class PxReader {
+public:
+	explicit PxReader(const string &header) : pos(header.data()), end(header.data() + header.size()) {
+	}
+
+	//! Read the next header keyword; false at DATA or at the end of the header
+	bool NextKeyword(PxKeyword &keyword) {
+		SkipWhitespace();
+		if (pos >= end) {
+			return false;
+		}
+		keyword = PxKeyword();
+		while (pos < end && *pos != '=' && *pos != '[' && *pos != '(') {
+			keyword.name += *pos++;
+		}
+		keyword.name = StringUtil::Upper(keyword.name);
+		StringUtil::Trim(keyword.name);
+		if (pos < end && *pos == '[') {
+			pos++;
+			while (pos < end && *pos != ']') {
+				keyword.language += *pos++;
+			}
+			pos++;
+		}
+		if (pos < end && *pos == '(') {
+			pos++;
+			SkipWhitespace();
+			keyword.subkey = ReadQuoted();
+			while (pos < end && *pos != ')') {
+				pos++;
+			}
+			pos++;
+		}
+		SkipWhitespace();
+		if (pos >= end || *pos != '=') {
+			throw IOException("PX: malformed keyword %s", keyword.name);
+		}
+		pos++;
+		if (keyword.name == "DATA") {
+			return false;
+		}
+		ReadValues(keyword.values);
+		return true;
+	}
+
+private:
+	void SkipWhitespace() {
+		while (pos < end && IsPxSpace(*pos)) {
+			pos++;
+		}
+	}
+
+	string ReadQuoted() {
+		string result;
+		if (pos >= end || *pos != '"') {
+			return result;
+		}
+		pos++;
+		while (pos < end && *pos != '"') {
+			result += *pos++;
+		}
+		pos++;
+		return result;
+	}
+
+	//! Comma separated values up to the terminating semicolon. Quoted strings separated only by whitespace are one
+	//! string that was wrapped across lines.
+	void ReadValues(vector<string> &values) {
+		bool continues_string = false;
+		while (pos < end) {
+			SkipWhitespace();
+			if (pos >= end) {
+				break;
+			}
+			if (*pos == ';') {
+				pos++;
+				return;
+			}
+			if (*pos == ',') {
+				pos++;
+				continues_string = false;
+				continue;
+			}
+			if (*pos == '"') {
+				auto text = ReadQuoted();
+				if (continues_string && !values.empty()) {
+					values.back() += text;
+				} else {
+					values.push_back(std::move(text));
+				}
+				continues_string = true;
+				continue;
+			}
+			string token;
+			while (pos < end && *pos != ',' && *pos != ';' && !IsPxSpace(*pos)) {
+				token += *pos++;
+			}
+			values.push_back(std::move(token));
+			continues_string = false;
+		}
+		throw IOException("PX: unterminated keyword value");
+	}
+
+	const char *pos;
+	const char *end;
+};
+
+} // namespace
+
+//! Code points of the bytes 0x80-0xFF in the single-byte code pages PX files are written in
+static const uint16_t WINDOWS_1250[] = {
+	0x20AC, 0xFFFD, 0x201A, 0xFFFD, 0x201E, 0x2026, 0x2020, 0x2021,
+	0xFFFD, 0x2030, 0x0160, 0x2039, 0x015A, 0x0164, 0x017D, 0x0179,
+	0xFFFD, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+	0xFFFD, 0x2122, 0x0161, 0x203A, 0x015B, 0x0165, 0x017E, 0x017A,
+	0x00A0, 0x02C7, 0x02D8, 0x0141, 0x00A4, 0x0104, 0x00A6, 0x00A7,
+	0x00A8, 0x00A9, 0x015E, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x017B,
+	0x00B0, 0x00B1, 0x02DB, 0x0142, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+	0x00B8, 0x0105, 0x015F, 0x00BB, 0x013D, 0x02DD, 0x013E, 0x017C,
+	0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7,
+	0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E,
+	0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7,
+	0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF,
+	0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7,
+	0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F,
+	0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7,
+	0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9,
+};
+
+static const uint16_t ISO_8859_2[] = {
+	0x0080, 0x0081, 0x0082, 0x0083, 0x0084, 0x0085, 0x0086, 0x0087,
+	0x0088, 0x0089, 0x008A, 0x008B, 0x008C, 0x008D, 0x008E, 0x008F,
+	0x0090, 0x0091, 0x0092, 0x0093, 0x0094, 0x0095, 0x0096, 0x0097,
+	0x0098, 0x0099, 0x009A, 0x009B, 0x009C, 0x009D, 0x009E, 0x009F,
+	0x00A0, 0x0104, 0x02D8, 0x0141, 0x00A4, 0x013D, 0x015A, 0x00A7,
+	0x00A8, 0x0160, 0x015E, 0x0164, 0x0179, 0x00AD, 0x017D, 0x017B,
+	0x00B0, 0x0105, 0x02DB, 0x0142, 0x00B4, 0x013E, 0x015B, 0x02C7,
+	0x00B8, 0x0161, 0x015F, 0x0165, 0x017A, 0x02DD, 0x017E, 0x017C,
+	0x0154, 0x00C1, 0x00C2, 0x0102, 0x00C4, 0x0139, 0x0106, 0x00C7,
+	0x010C, 0x00C9, 0x0118, 0x00CB, 0x011A, 0x00CD, 0x00CE, 0x010E,
+	0x0110, 0x0143, 0x0147, 0x00D3, 0x00D4, 0x0150, 0x00D6, 0x00D7,
+	0x0158, 0x016E, 0x00DA, 0x0170, 0x00DC, 0x00DD, 0x0162, 0x00DF,
+	0x0155, 0x00E1, 0x00E2, 0x0103, 0x00E4, 0x013A, 0x0107, 0x00E7,
+	0x010D, 0x00E9, 0x0119, 0x00EB, 0x011B, 0x00ED, 0x00EE, 0x010F,
+	0x0111, 0x0144, 0x0148, 0x00F3, 0x00F4, 0x0151, 0x00F6, 0x00F7,
+	0x0159, 0x016F, 0x00FA, 0x0171, 0x00FC, 0x00FD, 0x0163, 0x02D9,
+};
+
+static const uint16_t WINDOWS_1252[] = {
+	0x20AC, 0xFFFD, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+	0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0xFFFD, 0x017D, 0xFFFD,
+	0xFFFD, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+	0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0xFFFD, 0x017E, 0x0178,
+	0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+	0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+	0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+	0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+	0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+	0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+	0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+	0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+	0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+	0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+	0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+	0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF,
+};
+
+PxCodepage PxCodepage::FromHeader(const string &header) {
+	PxCodepage result;
+	PxReader reader(header);
+	PxKeyword keyword;
+	while (reader.NextKeyword(keyword)) {
+		if (keyword.name == "CODEPAGE" && keyword.language.empty() && !keyword.values.empty()) {
+			result.name = keyword.values[0];
+		}
+	}
+	string normalized;
+	for (auto c : StringUtil::Lower(result.name)) {
+		if (c != '-' && c != '_' && !IsPxSpace(c)) {
+			normalized += c;
+		}
+	}
+	if (normalized.empty() || normalized == "utf8") {
+		return result;
+	}
+	if (normalized == "windows1250" || normalized == "cp1250" || normalized == "1250") {
+		result.high_bytes = WINDOWS_1250;
+	} else if (normalized == "iso88592" || normalized == "latin2") {
+		result.high_bytes = ISO_8859_2;
+	} else if (normalized == "windows1252" || normalized == "cp1252" || normalized == "1252") {
+		result.high_bytes = WINDOWS_1252;
+	} else if (normalized == "iso88591" || normalized == "latin1") {
+		result.latin1 = true;
+	} else {
+		result.unsupported = true;
+	}
+	return result;
+}
+
+string PxCodepage::ToUtf8(const string &text) const {
+	if (!high_bytes && !latin1 && !unsupported) {
+		return text;
+	}
+	string result;
+	result.reserve(text.size());
+	for (auto c : text) {
+		auto byte = static_cast<uint8_t>(c);
+		if (byte < 0x80) {
+			result += c;
+			continue;
+		}
+		if (unsupported) {
+			throw IOException("PX: unsupported CODEPAGE \"%s\"", name);
+		}
+		uint32_t code_point = high_bytes ? high_bytes[byte - 0x80] : byte;
+		if (code_point < 0x800) {
+			result += static_cast<char>(0xC0 | (code_point >> 6));
+		} else {
+			result += static_cast<char>(0xE0 | (code_point >> 12));
+			result += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+		}
+		result += static_cast<char>(0x80 | (code_point & 0x3F));
+	}
+	return result;
+}
+
+//! Scan a header for the DATA keyword from `from` on; returns the offset just past its '=', or INVALID_INDEX when the
+//! header continues. Quote and keyword state carry over between calls.
+static idx_t FindDataStart(const string &text, idx_t from, bool &in_quotes, idx_t &keyword_start) {
+	for (idx_t i = from; i < text.size(); i++) {
+		char c = text[i];
+		if (c == '"') {
+			in_quotes = !in_quotes;
+		} else if (!in_quotes && c == ';') {
+			keyword_start = i + 1;
+		} else if (!in_quotes && c == '=') {
+			auto name = text.substr(keyword_start, i - keyword_start);
+			StringUtil::Trim(name);
+			if (StringUtil::CIEquals(name, "DATA")) {
+				return i + 1;
+			}
+		}
+	}
+	return DConstants::INVALID_INDEX;
+}
+
+PxStreamDecoder::PxStreamDecoder(Allocator &allocator_p, JsonStatCube &cube_p, vector<string> dimension_names_p,
+                                 vector<string> dimension_texts_p)
+    : allocator(allocator_p), cube(cube_p), dimension_names(std::move(dimension_names_p)),
+      dimension_texts(std::move(dimension_texts_p)) {
+}
+
+void PxStreamDecoder::Feed(const char *data, idx_t size) {
+	idx_t consumed = 0;
+	if (!started) {
+		FeedHeader(data, size, consumed);
+		if (!started) {
+			return;
+		}
+	}
+	FeedData(data + consumed, size - consumed);
+}
+
+void PxStreamDecoder::FeedHeader(const char *data, idx_t size, idx_t &consumed) {
+	header.append(data, size);
+	auto data_start = FindDataStart(header, header_scanned, header_in_quotes, keyword_start);
+	if (data_start == DConstants::INVALID_INDEX) {
+		header_scanned = header.size();
+		consumed = size;
+		return;
+	}
+	// The rest of this piece already belongs to DATA
+	consumed = size - (header.size() - data_start);
+	header.resize(data_start);
+	LayoutCube();
+	started = true;
+}
+
+//! Variable codes and category codes of a PX header, in cube order
+static void ParseLayout(const string &header, const vector<string> &dimension_names,
+                        const vector<string> &dimension_texts, vector<string> &dimension_ids,
+                        vector<vector<string>> &codes_per_dim, PxCodepage &codepage) {
+	codepage = PxCodepage::FromHeader(header);
+	// Delimiters are ASCII, which UTF-8 never uses within a multi-byte character, so the converted header parses alike
+	auto text = codepage.ToUtf8(header);
+	PxReader reader(text);
+	vector<string> variables;
+	unordered_map<string, vector<string>> codes;
+	unordered_map<string, vector<string>> values;
+	unordered_map<string, string> variable_codes;
+
+	PxKeyword keyword;
+	while (reader.NextKeyword(keyword)) {
+		if (!keyword.language.empty()) {
+			// Translations of the header; the main language is the one requested from the API
+			continue;
+		}
+		if (keyword.name == "STUB" || keyword.name == "HEADING") {
+			// Data is laid out with the stub variables as rows and the heading variables as columns
+			variables.insert(variables.end(), keyword.values.begin(), keyword.values.end());
+		} else if (keyword.name == "CODES") {
+			codes[keyword.subkey] = std::move(keyword.values);
+		} else if (keyword.name == "VALUES") {
+			values[keyword.subkey] = std::move(keyword.values);
+		} else if (keyword.name == "VARIABLECODE" && !keyword.values.empty()) {
+			variable_codes[keyword.subkey] = keyword.values[0];
+		}
+	}
+
+	for (auto &variable : variables) {
+		auto code = variable_codes.find(variable);
+		if (code != variable_codes.end()) {
+			dimension_ids.push_back(code->second);
+		} else if (dimension_texts.empty()) {
+			// Without table metadata the variable name is all there is
+			dimension_ids.push_back(variable);
+		} else {
+			auto text = std::find(dimension_texts.begin(), dimension_texts.end(), variable);
+			if (text == dimension_texts.end()) {
+				throw IOException("PX: variable \"%s\" does not match the table metadata", variable);
+			}
+			dimension_ids.push_back(dimension_names[static_cast<idx_t>(text - dimension_texts.begin())]);
+		}
+		auto variable_codes_entry = codes.find(variable);
+		if (variable_codes_entry != codes.end()) {
+			codes_per_dim.push_back(std::move(variable_codes_entry->second));
+		} else {
+			auto variable_values = values.find(variable);
+			if (variable_values == values.end()) {
+				throw IOException("PX: no CODES or VALUES for variable \"%s\"", variable);
+			}
+			codes_per_dim.push_back(std::move(variable_values->second));
+		}
+	}
+}
+
+void PxStreamDecoder::LayoutCube() {
+	vector<string> dimension_ids;
+	vector<vector<string>> codes_per_dim;
+	ParseLayout(header, dimension_names, dimension_texts, dimension_ids, codes_per_dim, codepage);
+	cube.Initialize(allocator, std::move(dimension_ids), std::move(codes_per_dim));
+	header = string();
+}
+
+void PxStreamDecoder::FeedData(const char *data, idx_t size) {
+	for (idx_t i = 0; i < size && !data_finished; i++) {
+		char c = data[i];
+		if (in_quotes) {
+			if (c == '"') {
+				in_quotes = false;
+				EmitToken(true);
+			} else {
+				token += c;
+			}
+		} else if (c == '"') {
+			if (in_token) {
+				EmitToken(false);
+			}
+			in_quotes = true;
+		} else if (IsPxSpace(c) || c == ',' || c == ';') {
+			if (in_token) {
+				EmitToken(false);
+			}
+			data_finished = c == ';';
+		} else {
+			token += c;
+			in_token = true;
+		}
+	}
+}
+
+void PxStreamDecoder::EmitToken(bool quoted) {
+	if (cell >= cube.CellCount()) {
+		throw IOException("PX: more DATA values than cells (%d)", cube.CellCount());
+	}
+	double number;
+	string_t text(token.c_str(), static_cast<uint32_t>(token.size()));
+	if (!quoted && TryCast::Operation<string_t, double>(text, number, true)) {
+		cube.values[cell] = number;
+	} else if (!token.empty()) {
+		// Missing values are written as dot or dash symbols
+		cube.status_ids[cell] = cube.StatusId(codepage.ToUtf8(token));
+	}
+	token.clear();
+	in_token = false;
+	cell++;
+}
+
+void PxStreamDecoder::Finish() {
+	if (!started) {
+		throw IOException("PX: response has no DATA");
+	}
+	if (in_token) {
+		EmitToken(false);
+	}
+	if (cell != cube.CellCount()) {
+		throw IOException("PX: expected %d DATA values, found %d", cube.CellCount(), cell);
+	}
+}
+
+bool PxFile::ReadLayout(const string &prefix, const vector<string> &dimension_names,
+                        const vector<string> &dimension_texts, vector<string> &dimension_ids,
+                        vector<vector<string>> &codes_per_dim) {
+	bool in_quotes = false;
+	idx_t keyword_start = 0;
+	auto data_start = FindDataStart(prefix, 0, in_quotes, keyword_start);
+	if (data_start == DConstants::INVALID_INDEX) {
+		return false;
+	}
+	PxCodepage codepage;
+	ParseLayout(prefix.substr(0, data_start), dimension_names, dimension_texts, dimension_ids, codes_per_dim,
+	            codepage);
+	return true;
+}
+
+JsonStatCube PxFile::Parse(const string &body, const vector<string> &dimension_names,
+                           const vector<string> &dimension_texts, Allocator &allocator) {
+	JsonStatCube cube;
+	PxStreamDecoder decoder(allocator, cube, dimension_names, dimension_texts);
+	decoder.Feed(body.data(), body.size());
+	decoder.Finish();
+	return cube;
+}
+
+} // namespace duckdb
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "json_stat.hpp"
+
+namespace duckdb {
+
+//! Text encoding of a PX file, declared by its CODEPAGE keyword. PxWeb writes Slovenian tables in windows-1250, so
+//! their texts (and codes taken from VALUES) are converted to UTF-8 before they are matched with the metadata.
+struct PxCodepage {
+	//! The code page a header declares; text of a file without CODEPAGE is taken as it is
+	static PxCodepage FromHeader(const string &header);
+	//! `text` converted to UTF-8
+	string ToUtf8(const string &text) const;
+
+	string name;
+	//! Code points of the bytes 0x80-0xFF; not set when bytes are their own code points or the text is kept as is
+	const uint16_t *high_bytes = nullptr;
+	//! ISO-8859-1, whose bytes are their own code points
+	bool latin1 = false;
+	//! A code page that is not supported, in which only ASCII text can be read
+	bool unsupported = false;
+};
+
+//! Incremental PX decoder. The header is buffered until the DATA keyword; from then on values are decoded into the
+//! cube as the body arrives, so cells can be consumed before the download completes and the body is never held.
+class PxStreamDecoder {
+public:
+	//! PX names variables by their text, so unless the file carries VARIABLECODE keywords, `dimension_texts` (from the
+	//! table metadata) maps them back to `dimension_names`. Without metadata the variable names are used as is.
+	PxStreamDecoder(Allocator &allocator, JsonStatCube &cube, vector<string> dimension_names,
+	                vector<string> dimension_texts);
+
+	//! Decode the next piece of the body
+	void Feed(const char *data, idx_t size);
+	//! Check that the body was complete
+	void Finish();
+	//! Whether the header was decoded, i.e. the cube has its dimensions and cell count
+	bool Started() const {
+		return started;
+	}
+	//! Number of leading cells whose value and status are final
+	idx_t CellsDecoded() const {
+		return cell;
+	}
+
+private:
+	void FeedHeader(const char *data, idx_t size, idx_t &consumed);
+	void LayoutCube();
+	void FeedData(const char *data, idx_t size);
+	void EmitToken(bool quoted);
+
+	Allocator &allocator;
+	JsonStatCube &cube;
+	vector<string> dimension_names;
+	vector<string> dimension_texts;
+
+	//! Encoding of the header and of status symbols in DATA
+	PxCodepage codepage;
+	//! Header text up to and including "DATA="
+	string header;
+	idx_t header_scanned = 0;
+	idx_t keyword_start = 0;
+	bool header_in_quotes = false;
+	bool started = false;
+
+	//! DATA token that may continue in the next piece
+	string token;
+	bool in_token = false;
+	bool in_quotes = false;
+	bool data_finished = false;
+	idx_t cell = 0;
+};
+
+struct PxFile {
+	//! Dimensions and codes from the header at the start of a PX body, without allocating the cube; false when
+	//! `prefix` does not contain the whole header yet
+	static bool ReadLayout(const string &prefix, const vector<string> &dimension_names,
+	                       const vector<string> &dimension_texts, vector<string> &dimension_ids,
+	                       vector<vector<string>> &codes_per_dim);
+	//! Parse a complete PX file as returned by PxWeb into a cube allocated from `allocator`
+	static JsonStatCube Parse(const string &body, const vector<string> &dimension_names,
+	                          const vector<string> &dimension_texts, Allocator &allocator);
+};
+
+} // namespace duckdb
@@ -0,0 +1,365 @@
+#include "response_cache.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/hash.hpp"
+#include "miniz.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace duckdb {
+
+static constexpr const char *CACHE_MAGIC = "SISTATC1";
+static constexpr idx_t CACHE_MAGIC_SIZE = 8;
+static constexpr const char *CACHE_EXTENSION = ".sistat";
+static constexpr const char *TEMP_EXTENSION = ".tmp";
+//! Temporary files older than this are left over from a failed write rather than still being written
+static constexpr int64_t ORPHANED_TEMP_AGE_SEC = 3600;
+
+struct CachedResponse {
+	//! Seconds since the epoch at which the entry was stored or last revalidated
+	int64_t stored_at = 0;
+	string key;
+	string etag;
+	string last_modified;
+	string content_type;
+	string body;
+};
+
+static int64_t CurrentTime() {
+	return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch())
+	    .count();
+}
+
+static string CacheKey(const string &url, const string &method, const string &request_body) {
+	return StringUtil::Upper(method) + " " + url + "\n" + request_body;
+}
+
+static string CachePath(FileSystem &fs, const string &directory, const string &key) {
+	return fs.JoinPath(directory, StringUtil::Format("%016x%s", Hash(key.c_str(), key.size()), CACHE_EXTENSION));
+}
+
+static string Compress(const string &data) {
+	auto bound = duckdb_miniz::mz_compressBound(data.size());
+	string compressed(bound, '\0');
+	duckdb_miniz::mz_ulong compressed_size = bound;
+	if (duckdb_miniz::mz_compress2(reinterpret_cast<unsigned char *>(&compressed[0]), &compressed_size,
+	                               reinterpret_cast<const unsigned char *>(data.data()), data.size(),
+	                               duckdb_miniz::MZ_DEFAULT_COMPRESSION) != duckdb_miniz::MZ_OK) {
+		throw IOException("SISTAT cache: failed to compress response");
+	}
+	compressed.resize(compressed_size);
+	return compressed;
+}
+
+static bool Decompress(const string &compressed, idx_t size, string &data) {
+	data.resize(size);
+	duckdb_miniz::mz_ulong data_size = size;
+	if (duckdb_miniz::mz_uncompress(reinterpret_cast<unsigned char *>(&data[0]), &data_size,
+	                                reinterpret_cast<const unsigned char *>(compressed.data()),
+	                                compressed.size()) != duckdb_miniz::MZ_OK) {
+		return false;
+	}
+	return data_size == size;
+}
+
+static void AppendFixed(string &out, uint64_t value) {
+	out.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void AppendString(string &out, const string &value) {
+	AppendFixed(out, value.size());
+	out += value;
+}
+
+static bool ReadFixed(const string &in, idx_t &offset, uint64_t &value) {
+	if (offset + sizeof(value) > in.size()) {
+		return false;
+	}
+	memcpy(&value, in.data() + offset, sizeof(value));
+	offset += sizeof(value);
+	return true;
+}
+
+static bool ReadString(const string &in, idx_t &offset, string &value) {
+	uint64_t size;
+	if (!ReadFixed(in, offset, size) || size > in.size() - offset) {
+		return false;
+	}
+	value = in.substr(offset, size);
+	offset += size;
+	return true;
+}
+
+static string ReadFile(FileSystem &fs, const string &path, idx_t max_bytes) {
+	auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+	if (!handle) {
+		return string();
+	}
+	auto size = MinValue<idx_t>(handle->GetFileSize(), max_bytes);
+	string contents(size, '\0');
+	handle->Read(&contents[0], size);
+	return contents;
+}
+
+//! Temporary files are named <entry>.sistat.<random>.tmp
+static bool IsTempFile(const string &name) {
+	return StringUtil::EndsWith(name, TEMP_EXTENSION) && name.find(CACHE_EXTENSION) != string::npos;
+}
+
+static void TryRemoveFile(FileSystem &fs, const string &path) {
+	try {
+		fs.RemoveFile(path);
+	} catch (std::exception &) {
+		// Another process may have removed it already
+	}
+}
+
+static bool TryReadEntry(FileSystem &fs, const string &path, const string &key, CachedResponse &entry) {
+	string contents;
+	try {
+		contents = ReadFile(fs, path, NumericLimits<idx_t>::Maximum());
+	} catch (std::exception &) {
+		return false;
+	}
+	if (contents.size() < CACHE_MAGIC_SIZE || contents.compare(0, CACHE_MAGIC_SIZE, CACHE_MAGIC) != 0) {
+		return false;
+	}
+	idx_t offset = CACHE_MAGIC_SIZE;
+	uint64_t stored_at, body_size;
+	string compressed;
+	if (!ReadFixed(contents, offset, stored_at) || !ReadFixed(contents, offset, body_size) ||
+	    !ReadString(contents, offset, entry.key) || !ReadString(contents, offset, entry.etag) ||
+	    !ReadString(contents, offset, entry.last_modified) || !ReadString(contents, offset, entry.content_type) ||
+	    !ReadString(contents, offset, compressed)) {
+		return false;
+	}
+	// The file name is a hash of the key, so a different key is a collision rather than a hit
+	if (entry.key != key || !Decompress(compressed, body_size, entry.body)) {
+		return false;
+	}
+	entry.stored_at = static_cast<int64_t>(stored_at);
+	return true;
+}
+
+//! Remove the oldest entries until the directory fits in `max_size` bytes
+static void EvictEntries(FileSystem &fs, const string &directory, idx_t max_size) {
+	struct EntryFile {
+		string path;
+		int64_t stored_at;
+		idx_t size;
+	};
+	vector<EntryFile> files;
+	idx_t total_size = 0;
+	vector<string> orphaned;
+	auto now = CurrentTime();
+	fs.ListFiles(directory, [&](const string &name, bool is_directory) {
+		bool is_temp = IsTempFile(name);
+		if (is_directory || (!is_temp && !StringUtil::EndsWith(name, CACHE_EXTENSION))) {
+			return;
+		}
+		EntryFile file {fs.JoinPath(directory, name), 0, 0};
+		try {
+			auto handle = fs.OpenFile(file.path, FileFlags::FILE_FLAGS_READ | FileFlags::FILE_FLAGS_NULL_IF_NOT_EXISTS);
+			if (!handle) {
+				return;
+			}
+			file.size = handle->GetFileSize();
+			char header[CACHE_MAGIC_SIZE + sizeof(uint64_t)];
+			if (file.size >= sizeof(header)) {
+				handle->Read(header, sizeof(header));
+				uint64_t stored_at;
+				memcpy(&stored_at, header + CACHE_MAGIC_SIZE, sizeof(stored_at));
+				file.stored_at = static_cast<int64_t>(stored_at);
+			}
+		} catch (std::exception &) {
+			return;
+		}
+		if (is_temp) {
+			// Temporary files carry the time their write started; recent ones may still be renamed into place
+			if (file.stored_at > 0 && now - file.stored_at > ORPHANED_TEMP_AGE_SEC) {
+				orphaned.push_back(std::move(file.path));
+			} else {
+				total_size += file.size;
+			}
+			return;
+		}
+		total_size += file.size;
+		files.push_back(std::move(file));
+	});
+	for (auto &path : orphaned) {
+		TryRemoveFile(fs, path);
+	}
+	if (total_size <= max_size) {
+		return;
+	}
+	std::sort(files.begin(), files.end(),
+	          [](const EntryFile &a, const EntryFile &b) { return a.stored_at < b.stored_at; });
+	for (auto &file : files) {
+		if (total_size <= max_size) {
+			break;
+		}
+		TryRemoveFile(fs, file.path);
+		total_size -= file.size;
+	}
+}
+
+static void WriteEntry(FileSystem &fs, const string &directory, const string &path, const CachedResponse &entry,
+                       idx_t max_size) {
+	string contents(CACHE_MAGIC, CACHE_MAGIC_SIZE);
+	AppendFixed(contents, static_cast<uint64_t>(entry.stored_at));
+	AppendFixed(contents, entry.body.size());
+	AppendString(contents, entry.key);
+	AppendString(contents, entry.etag);
+	AppendString(contents, entry.last_modified);
+	AppendString(contents, entry.content_type);
+	AppendString(contents, Compress(entry.body));
+	if (contents.size() > max_size) {
+		return;
+	}
+
+	if (!fs.DirectoryExists(directory)) {
+		fs.CreateDirectory(directory);
+	}
+	// Readers in other processes only ever see complete files: write under a unique name, then rename
+	RandomEngine random;
+	auto temp_path = StringUtil::Format("%s.%08x.tmp", path, random.NextRandomInteger());
+	try {
+		auto handle = fs.OpenFile(temp_path, FileFlags::FILE_FLAGS_WRITE | FileFlags::FILE_FLAGS_FILE_CREATE_NEW);
+		handle->Write(&contents[0], contents.size());
+		handle->Sync();
+		handle->Close();
+		ResponseCache::ReplaceFile(fs, temp_path, path);
+	} catch (std::exception &) {
+		TryRemoveFile(fs, temp_path);
+		throw;
+	}
+	EvictEntries(fs, directory, max_size);
+}
+
+static string HeaderValue(const HttpResponseData &response, const string &name) {
+	for (idx_t i = 0; i < response.header_keys.size(); i++) {
+		if (StringUtil::CIEquals(response.header_keys[i].GetValue<string>(), name)) {
+			return response.header_values[i].GetValue<string>();
+		}
+	}
+	return string();
+}
+
+static HttpResponseData CachedResult(const CachedResponse &entry) {
+	HttpResponseData result;
+	result.status_code = 200;
+	result.content_type = entry.content_type;
+	result.content_length = static_cast<int64_t>(entry.body.size());
+	result.body = entry.body;
+	return result;
+}
+
+HttpResponseData ResponseCache::ExecuteRequest(const HttpSettings &settings, const string &url, const string &method,
+                                               const duckdb_httplib_openssl::Headers &headers,
+                                               const string &request_body, const string &content_type) {
+	if (!settings.use_cache) {
+		return HttpRequest::ExecuteHttpRequest(settings, url, method, headers, request_body, content_type);
+	}
+
+	auto fs = FileSystem::CreateLocal();
+	auto key = CacheKey(url, method, request_body);
+	auto path = CachePath(*fs, settings.cache_directory, key);
+
+	CachedResponse entry;
+	bool cached = TryReadEntry(*fs, path, key, entry);
+	auto now = CurrentTime();
+	if (cached && now - entry.stored_at < static_cast<int64_t>(settings.cache_max_age)) {
+		settings.stats.Add(&SistatStats::disk_cache_hits, 1);
+		return CachedResult(entry);
+	}
+
+	auto request_headers = headers;
+	if (cached && !entry.etag.empty()) {
+		request_headers.insert({"If-None-Match", entry.etag});
+	}
+	if (cached && !entry.last_modified.empty()) {
+		request_headers.insert({"If-Modified-Since", entry.last_modified});
+	}
+	auto response =
+	    HttpRequest::ExecuteHttpRequest(settings, url, method, request_headers, request_body, content_type);
+
+	try {
+		if (cached && response.error.empty() && response.status_code == 304) {
+			entry.stored_at = now;
+			WriteEntry(*fs, settings.cache_directory, path, entry, settings.cache_max_size);
+			settings.stats.Add(&SistatStats::disk_cache_hits, 1);
+			return CachedResult(entry);
+		}
+		if (response.error.empty() && response.status_code == 200) {
+			CachedResponse fresh;
+			fresh.stored_at = now;
+			fresh.key = key;
+			fresh.etag = HeaderValue(response, "ETag");
+			fresh.last_modified = HeaderValue(response, "Last-Modified");
+			fresh.content_type = response.content_type;
+			fresh.body = response.body;
+			WriteEntry(*fs, settings.cache_directory, path, fresh, settings.cache_max_size);
+		}
+	} catch (std::exception &) {
+		// The cache is best effort: an unwritable directory must not fail the query
+	}
+	if (cached && (!response.error.empty() || response.status_code >= 500)) {
+		// Serve the stale copy rather than failing while the server is unreachable
+		settings.stats.Add(&SistatStats::disk_cache_hits, 1);
+		return CachedResult(entry);
+	}
+	settings.stats.Add(&SistatStats::disk_cache_misses, 1);
+	return response;
+}
+
+idx_t ResponseCache::Clear(const string &directory) {
+	if (directory.empty()) {
+		return 0;
+	}
+	auto fs = FileSystem::CreateLocal();
+	if (!fs->DirectoryExists(directory)) {
+		return 0;
+	}
+	vector<string> paths;
+	vector<string> temp_paths;
+	fs->ListFiles(directory, [&](const string &name, bool is_directory) {
+		if (is_directory) {
+			return;
+		}
+		if (StringUtil::EndsWith(name, CACHE_EXTENSION)) {
+			paths.push_back(fs->JoinPath(directory, name));
+		} else if (IsTempFile(name)) {
+			temp_paths.push_back(fs->JoinPath(directory, name));
+		}
+	});
+	idx_t removed = 0;
+	for (auto &path : paths) {
+		try {
+			fs->RemoveFile(path);
+			removed++;
+		} catch (std::exception &) {
+		}
+	}
+	for (auto &path : temp_paths) {
+		TryRemoveFile(*fs, path);
+	}
+	return removed;
+}
+
+void ResponseCache::ReplaceFile(FileSystem &fs, const string &source, const string &target) {
+	try {
+		fs.MoveFile(source, target);
+	} catch (std::exception &) {
+		if (!fs.FileExists(target)) {
+			throw;
+		}
+		// Readers of the old file in other processes then briefly see no entry, which is a cache miss
+		fs.RemoveFile(target);
+		fs.MoveFile(source, target);
+	}
+}
+
+} // namespace duckdb
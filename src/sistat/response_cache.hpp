@@ -0,0 +1,30 @@
+#pragma once
+
+#include "http_request.hpp"
+
+namespace duckdb {
+
+class FileSystem;
+
+//! Optional on-disk cache of HTTP responses, enabled by setting `sistat_cache_directory`.
+//!
+//! Entries are keyed by method, URL and request body, and stored compressed, one file per entry. A fresh entry
+//! (younger than `sistat_cache_max_age` seconds) is served without contacting the server; an older one is
+//! revalidated with If-None-Match / If-Modified-Since when the server supplied an ETag or Last-Modified, so an
+//! unchanged table costs a 304 instead of a download. Files are written to a temporary name and renamed into
+//! place, so several processes can share one directory; the oldest entries are removed once the directory
+//! grows past `sistat_cache_max_size` bytes.
+struct ResponseCache {
+	static HttpResponseData ExecuteRequest(const HttpSettings &settings, const string &url, const string &method,
+	                                       const duckdb_httplib_openssl::Headers &headers, const string &request_body,
+	                                       const string &content_type);
+
+	//! Remove every entry in `directory`, and temporary files left behind by failed writes, returning how many
+	//! entries were removed
+	static idx_t Clear(const string &directory);
+
+	//! Rename `source` onto `target`, replacing an existing file also where the rename itself cannot (Windows)
+	static void ReplaceFile(FileSystem &fs, const string &source, const string &target);
+};
+
+} // namespace duckdb
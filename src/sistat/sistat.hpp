@@ -1,6 +1,9 @@
 #pragma once
 
+#include "duckdb/common/constants.hpp"
 #include "duckdb/common/string.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
 
 namespace duckdb {
 namespace sistat {
@@ -9,8 +12,57 @@ constexpr const char *BASE_URL = "https://pxweb.stat.si/SiStatData/api/v1/";
 constexpr const char *DATA_PATH = "Data/";
 constexpr const char *DEFAULT_LANGUAGE = "en";
 
-inline string TableUrl(const string &lang, const string &table_id) {
-	return string(BASE_URL) + lang + "/" + DATA_PATH + table_id;
+//! Root of the PxWeb API; can point at a mirror, or at the mock server the load tests run against
+constexpr const char *BASE_URL_SETTING = "sistat_base_url";
+
+//! Largest number of cells requested from the server in a single data query
+constexpr const char *MAX_CELLS_PER_REQUEST_SETTING = "sistat_max_cells_per_request";
+constexpr idx_t DEFAULT_MAX_CELLS_PER_REQUEST = 100000;
+//! Largest number of concurrent requests issued by a single function call
+constexpr const char *MAX_CONCURRENCY_SETTING = "sistat_max_concurrency";
+constexpr idx_t DEFAULT_MAX_CONCURRENCY = 32;
+//! Request pacing and retries; the defaults match PxWeb's usual limit of 30 calls per 10 seconds
+constexpr const char *REQUESTS_PER_SECOND_SETTING = "sistat_requests_per_second";
+constexpr double DEFAULT_REQUESTS_PER_SECOND = 3.0;
+constexpr const char *REQUEST_BURST_SETTING = "sistat_request_burst";
+constexpr idx_t DEFAULT_REQUEST_BURST = 30;
+constexpr const char *RETRIES_SETTING = "sistat_http_retries";
+constexpr idx_t DEFAULT_RETRIES = 3;
+constexpr const char *RETRY_WAIT_MS_SETTING = "sistat_retry_wait_ms";
+constexpr idx_t DEFAULT_RETRY_WAIT_MS = 250;
+constexpr const char *RETRY_MAX_WAIT_MS_SETTING = "sistat_retry_max_wait_ms";
+constexpr idx_t DEFAULT_RETRY_MAX_WAIT_MS = 30000;
+//! Start downloading the full cube at bind time when it fits in a single request
+constexpr const char *PREFETCH_SETTING = "sistat_prefetch";
+//! Table metadata caching (see MetadataCache)
+constexpr const char *METADATA_CACHE_SETTING = "sistat_metadata_cache";
+constexpr const char *METADATA_CACHE_TTL_SETTING = "sistat_metadata_cache_ttl";
+constexpr idx_t DEFAULT_METADATA_CACHE_TTL = 3600;
+constexpr const char *METADATA_CACHE_MAX_ENTRIES_SETTING = "sistat_metadata_cache_max_entries";
+constexpr idx_t DEFAULT_METADATA_CACHE_ENTRIES = 256;
+//! On-disk response caching (see ResponseCache); disabled while the directory is empty
+constexpr const char *CACHE_DIRECTORY_SETTING = "sistat_cache_directory";
+//! Directory of local table snapshots written by SISTAT_Mirror (see SistatMirror); empty reads from the server
+constexpr const char *MIRROR_DIRECTORY_SETTING = "sistat_mirror_directory";
+constexpr const char *CACHE_MAX_SIZE_SETTING = "sistat_cache_max_size";
+constexpr idx_t DEFAULT_CACHE_MAX_SIZE = 1024ULL * 1024ULL * 1024ULL;
+constexpr const char *CACHE_MAX_AGE_SETTING = "sistat_cache_max_age";
+constexpr idx_t DEFAULT_CACHE_MAX_AGE = 86400;
+
+//! The configured API root, ending in a slash
+inline string BaseUrl(ClientContext &context) {
+	Value setting;
+	if (context.TryGetCurrentSetting(BASE_URL_SETTING, setting) && !setting.IsNull()) {
+		auto base_url = StringValue::Get(setting);
+		if (!base_url.empty()) {
+			return StringUtil::EndsWith(base_url, "/") ? base_url : base_url + "/";
+		}
+	}
+	return BASE_URL;
+}
+
+inline string TableUrl(const string &base_url, const string &lang, const string &table_id) {
+	return base_url + lang + "/" + DATA_PATH + table_id;
 }
 
 inline string NormalizeTableId(const string &table_id) {
@@ -0,0 +1,463 @@
+#include "sistat_catalog.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/schema_catalog_entry.hpp"
+#include "duckdb/catalog/catalog_entry/table_catalog_entry.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/common/reference_map.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/attached_database.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/config.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/parser/parsed_data/create_schema_info.hpp"
+#include "duckdb/parser/parsed_data/create_table_info.hpp"
+#include "duckdb/storage/database_size.hpp"
+#include "duckdb/storage/storage_extension.hpp"
+#include "duckdb/storage/table_storage_info.hpp"
+#include "duckdb/transaction/transaction.hpp"
+#include "duckdb/transaction/transaction_manager.hpp"
+#include "sistat.hpp"
+#include "metadata_cache.hpp"
+#include "sistat_data_functions.hpp"
+#include "sistat_info_functions.hpp"
+
+namespace duckdb {
+
+namespace {
+
+constexpr const char *CATALOG_TYPE = "sistat";
+constexpr const char *FUNCTION_NAME = "SiStat catalog";
+
+[[noreturn]] void ThrowReadOnly(const string &catalog_name) {
+	throw BinderException("SiStat catalog \"%s\" is read-only", catalog_name);
+}
+
+//! Table name of a (normalized) table id, e.g. 05C1002S.px -> 05C1002S
+string EntryName(const string &table_id) {
+	return table_id.substr(0, table_id.size() - 3);
+}
+
+//! A SiStat table. Created from the table's metadata, which is kept so every scan binds SISTAT_Read without a request.
+class SistatTableEntry final : public TableCatalogEntry {
+public:
+	SistatTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info, string table_id_p,
+	                 string table_url_p, string language_p, string metadata_p)
+	    : TableCatalogEntry(catalog, schema, info), table_id(std::move(table_id_p)), table_url(std::move(table_url_p)),
+	      language(std::move(language_p)), metadata(std::move(metadata_p)) {
+	}
+
+	unique_ptr<BaseStatistics> GetStatistics(ClientContext &context, column_t column_id) override {
+		return nullptr;
+	}
+
+	//! SISTAT_Read with its usual filter and projection pushdown, or the table's mirrored snapshot like SISTAT_Read
+	TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override {
+		TableFunction mirror_scan;
+		if (SistatDataFunctions::TryBindMirror(context, table_id, language, GetColumns().GetColumnNames(),
+		                                       GetColumns().GetColumnTypes(), mirror_scan, bind_data)) {
+			return mirror_scan;
+		}
+		vector<LogicalType> return_types;
+		vector<string> names;
+		bind_data = SistatDataFunctions::BindRead(metadata, table_id, table_url, language, return_types, names);
+		return SistatDataFunctions::GetReadFunction();
+	}
+
+	TableStorageInfo GetStorageInfo(ClientContext &context) override {
+		return TableStorageInfo();
+	}
+
+private:
+	string table_id;
+	string table_url;
+	string language;
+	string metadata;
+};
+
+//! A table of the listing that is not bound yet: its name and title, but no columns. Listing the schema returns it
+//! so that a scan of the schema sends no metadata request; a reference by name binds the table instead.
+class SistatListedTableEntry final : public TableCatalogEntry {
+public:
+	SistatListedTableEntry(Catalog &catalog, SchemaCatalogEntry &schema, CreateTableInfo &info)
+	    : TableCatalogEntry(catalog, schema, info) {
+	}
+
+	unique_ptr<BaseStatistics> GetStatistics(ClientContext &context, column_t column_id) override {
+		return nullptr;
+	}
+
+	TableFunction GetScanFunction(ClientContext &context, unique_ptr<FunctionData> &bind_data) override {
+		throw InternalException("SiStat catalog: table \"%s\" was scanned before it was bound", name);
+	}
+
+	TableStorageInfo GetStorageInfo(ClientContext &context) override {
+		return TableStorageInfo();
+	}
+};
+
+class SistatCatalog;
+
+//! The only schema, `main`. Tables are bound on first use and then kept for the lifetime of the attachment.
+class SistatSchemaEntry final : public SchemaCatalogEntry {
+public:
+	SistatSchemaEntry(SistatCatalog &catalog, CreateSchemaInfo &info);
+
+	//! Lists every table of the listing without a request per table: tables whose metadata is not at hand (bound,
+	//! mirrored or in the metadata cache) are listed without columns
+	void Scan(ClientContext &context, CatalogType type, const std::function<void(CatalogEntry &)> &callback) override;
+	void Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) override;
+	optional_ptr<CatalogEntry> LookupEntry(CatalogTransaction transaction, const EntryLookupInfo &lookup_info) override;
+
+	optional_ptr<CatalogEntry> CreateIndex(CatalogTransaction transaction, CreateIndexInfo &info,
+	                                       TableCatalogEntry &table) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateFunction(CatalogTransaction transaction, CreateFunctionInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateTable(CatalogTransaction transaction, BoundCreateTableInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateView(CatalogTransaction transaction, CreateViewInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateSequence(CatalogTransaction transaction, CreateSequenceInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateTableFunction(CatalogTransaction transaction,
+	                                               CreateTableFunctionInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateCopyFunction(CatalogTransaction transaction,
+	                                              CreateCopyFunctionInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreatePragmaFunction(CatalogTransaction transaction,
+	                                                CreatePragmaFunctionInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateCollation(CatalogTransaction transaction, CreateCollationInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	optional_ptr<CatalogEntry> CreateType(CatalogTransaction transaction, CreateTypeInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	void DropEntry(ClientContext &context, DropInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+	void Alter(CatalogTransaction transaction, AlterInfo &info) override {
+		ThrowReadOnly(catalog.GetName());
+	}
+
+private:
+	//! Bound tables
+	vector<reference<SistatTableEntry>> BoundTables();
+	optional_ptr<SistatTableEntry> FindBound(const string &name);
+	CatalogEntry &ListedTable(const SistatInfoFunctions::TableListing &listing);
+	optional_ptr<SistatTableEntry> GetTable(ClientContext &context, const string &name);
+	SistatTableEntry &AddTable(ClientContext &context, const SistatInfoFunctions::TableListing &listing,
+	                           const string &metadata);
+
+	SistatCatalog &sistat_catalog;
+	mutex tables_lock;
+	case_insensitive_map_t<unique_ptr<SistatTableEntry>> tables;
+	//! Entries of the tables a scan of the schema listed before they were bound; kept, as queries may refer to them
+	case_insensitive_map_t<unique_ptr<SistatListedTableEntry>> listed_tables;
+};
+
+class SistatCatalog final : public Catalog {
+public:
+	SistatCatalog(AttachedDatabase &db, string path_p, string base_url_p, string language_p,
+	              case_insensitive_set_t table_ids_p)
+	    : Catalog(db), path(std::move(path_p)), base_url(std::move(base_url_p)), language(std::move(language_p)),
+	      table_ids(std::move(table_ids_p)) {
+	}
+
+	void Initialize(bool load_builtin) override {
+		CreateSchemaInfo info;
+		info.schema = DEFAULT_SCHEMA;
+		schema = make_uniq<SistatSchemaEntry>(*this, info);
+	}
+	string GetCatalogType() override {
+		return CATALOG_TYPE;
+	}
+
+	void ScanSchemas(ClientContext &context, std::function<void(SchemaCatalogEntry &)> callback) override {
+		callback(*schema);
+	}
+	optional_ptr<SchemaCatalogEntry> LookupSchema(CatalogTransaction transaction, const EntryLookupInfo &schema_lookup,
+	                                              OnEntryNotFound if_not_found) override {
+		if (schema_lookup.GetEntryName() == DEFAULT_SCHEMA) {
+			return schema.get();
+		}
+		if (if_not_found == OnEntryNotFound::RETURN_NULL) {
+			return nullptr;
+		}
+		throw BinderException("SiStat catalog \"%s\" only has the schema \"%s\"", GetName(), DEFAULT_SCHEMA);
+	}
+
+	optional_ptr<CatalogEntry> CreateSchema(CatalogTransaction transaction, CreateSchemaInfo &info) override {
+		ThrowReadOnly(GetName());
+	}
+	void DropSchema(ClientContext &context, DropInfo &info) override {
+		ThrowReadOnly(GetName());
+	}
+	PhysicalOperator &PlanCreateTableAs(ClientContext &context, PhysicalPlanGenerator &planner, LogicalCreateTable &op,
+	                                    PhysicalOperator &plan) override {
+		ThrowReadOnly(GetName());
+	}
+	PhysicalOperator &PlanInsert(ClientContext &context, PhysicalPlanGenerator &planner, LogicalInsert &op,
+	                             optional_ptr<PhysicalOperator> plan) override {
+		ThrowReadOnly(GetName());
+	}
+	PhysicalOperator &PlanDelete(ClientContext &context, PhysicalPlanGenerator &planner, LogicalDelete &op,
+	                             PhysicalOperator &plan) override {
+		ThrowReadOnly(GetName());
+	}
+	PhysicalOperator &PlanUpdate(ClientContext &context, PhysicalPlanGenerator &planner, LogicalUpdate &op,
+	                             PhysicalOperator &plan) override {
+		ThrowReadOnly(GetName());
+	}
+
+	DatabaseSize GetDatabaseSize(ClientContext &context) override {
+		return DatabaseSize();
+	}
+	bool InMemory() override {
+		return false;
+	}
+	string GetDBPath() override {
+		return path;
+	}
+
+	using Listing = case_insensitive_map_t<SistatInfoFunctions::TableListing>;
+
+	//! The tables of the catalog: the server's listing in the attached language, restricted to the TABLES option.
+	//! Kept for `sistat_metadata_cache_ttl` seconds, so tables added on the server appear; keyed by normalized
+	//! table id.
+	shared_ptr<const Listing> GetListing(ClientContext &context) {
+		auto ttl = MetadataCache::TimeToLive(context);
+		lock_guard<mutex> guard(listing_lock);
+		auto now = std::chrono::steady_clock::now();
+		if (!listing || now - listing_fetched_at >= ttl) {
+			auto list_url = sistat::TableUrl(base_url, language, "");
+			Listing result;
+			for (auto &table : SistatInfoFunctions::ListTables(context, list_url, FUNCTION_NAME)) {
+				table.table_id = sistat::NormalizeTableId(table.table_id);
+				if (table_ids.empty() || table_ids.find(table.table_id) != table_ids.end()) {
+					auto key = table.table_id;
+					result.emplace(std::move(key), std::move(table));
+				}
+			}
+			listing = make_shared_ptr<const Listing>(std::move(result));
+			listing_fetched_at = now;
+		}
+		return listing;
+	}
+
+	string TableUrl(const string &table_id) const {
+		return sistat::TableUrl(base_url, language, table_id);
+	}
+
+	const string path;
+	const string base_url;
+	const string language;
+
+private:
+	//! Table ids given in the TABLES option; empty exposes every table
+	case_insensitive_set_t table_ids;
+	unique_ptr<SistatSchemaEntry> schema;
+	mutex listing_lock;
+	//! Replaced rather than updated, so scans still holding the previous listing are unaffected
+	shared_ptr<const Listing> listing;
+	std::chrono::steady_clock::time_point listing_fetched_at;
+};
+
+SistatSchemaEntry::SistatSchemaEntry(SistatCatalog &catalog, CreateSchemaInfo &info)
+    : SchemaCatalogEntry(catalog, info), sistat_catalog(catalog) {
+}
+
+vector<reference<SistatTableEntry>> SistatSchemaEntry::BoundTables() {
+	lock_guard<mutex> guard(tables_lock);
+	vector<reference<SistatTableEntry>> result;
+	for (auto &entry : tables) {
+		result.push_back(*entry.second);
+	}
+	return result;
+}
+
+optional_ptr<SistatTableEntry> SistatSchemaEntry::FindBound(const string &name) {
+	lock_guard<mutex> guard(tables_lock);
+	auto entry = tables.find(name);
+	return entry == tables.end() ? nullptr : entry->second.get();
+}
+
+CatalogEntry &SistatSchemaEntry::ListedTable(const SistatInfoFunctions::TableListing &listing) {
+	auto name = EntryName(listing.table_id);
+	lock_guard<mutex> guard(tables_lock);
+	auto &entry = listed_tables[name];
+	if (!entry) {
+		CreateTableInfo info(*this, name);
+		info.comment = Value(listing.title);
+		entry = make_uniq<SistatListedTableEntry>(catalog, *this, info);
+	}
+	return *entry;
+}
+
+void SistatSchemaEntry::Scan(ClientContext &context, CatalogType type,
+                             const std::function<void(CatalogEntry &)> &callback) {
+	if (type != CatalogType::TABLE_ENTRY) {
+		return;
+	}
+	auto lookup = MetadataCache::CreateLookup(context, sistat_catalog.TableUrl(""));
+	auto listing = sistat_catalog.GetListing(context);
+	for (auto &table : *listing) {
+		optional_ptr<CatalogEntry> entry = FindBound(EntryName(table.first));
+		string metadata;
+		if (!entry && lookup.TryGetLocal(sistat_catalog.TableUrl(table.second.table_id), metadata)) {
+			try {
+				entry = &AddTable(context, table.second, metadata);
+			} catch (std::exception &) {
+				// A table that cannot be described should not hide all the others
+			}
+		}
+		callback(entry ? *entry : ListedTable(table.second));
+	}
+}
+
+void SistatSchemaEntry::Scan(CatalogType type, const std::function<void(CatalogEntry &)> &callback) {
+	if (type != CatalogType::TABLE_ENTRY) {
+		return;
+	}
+	for (auto &table : BoundTables()) {
+		callback(table.get());
+	}
+}
+
+optional_ptr<CatalogEntry> SistatSchemaEntry::LookupEntry(CatalogTransaction transaction,
+                                                          const EntryLookupInfo &lookup_info) {
+	if (lookup_info.GetCatalogType() != CatalogType::TABLE_ENTRY) {
+		return nullptr;
+	}
+	return GetTable(transaction.GetContext(), lookup_info.GetEntryName());
+}
+
+optional_ptr<SistatTableEntry> SistatSchemaEntry::GetTable(ClientContext &context, const string &name) {
+	auto table_id = sistat::NormalizeTableId(name);
+	auto bound = FindBound(EntryName(table_id));
+	if (bound) {
+		return bound;
+	}
+	// Unknown names are answered from the listing, so a typo costs no metadata request
+	auto listing = sistat_catalog.GetListing(context);
+	auto table = listing->find(table_id);
+	if (table == listing->end()) {
+		return nullptr;
+	}
+	auto metadata = MetadataCache::GetTableMetadata(context, sistat_catalog.TableUrl(table->second.table_id),
+	                                                FUNCTION_NAME);
+	return AddTable(context, table->second, metadata);
+}
+
+SistatTableEntry &SistatSchemaEntry::AddTable(ClientContext &context, const SistatInfoFunctions::TableListing &listing,
+                                              const string &metadata) {
+	auto table_url = sistat_catalog.TableUrl(listing.table_id);
+	vector<LogicalType> return_types;
+	vector<string> names;
+	SistatDataFunctions::BindRead(metadata, listing.table_id, table_url, sistat_catalog.language, return_types, names);
+
+	auto name = EntryName(listing.table_id);
+	CreateTableInfo info(*this, name);
+	for (idx_t i = 0; i < names.size(); i++) {
+		info.columns.AddColumn(ColumnDefinition(names[i], return_types[i]));
+	}
+	info.comment = Value(listing.title);
+	auto entry = make_uniq<SistatTableEntry>(catalog, *this, info, listing.table_id, std::move(table_url),
+	                                         sistat_catalog.language, metadata);
+
+	lock_guard<mutex> guard(tables_lock);
+	// A concurrent lookup may have bound the table first; its entry is kept, as it may already be in use
+	auto inserted = tables.emplace(std::move(name), std::move(entry));
+	return *inserted.first->second;
+}
+
+class SistatTransaction final : public Transaction {
+public:
+	SistatTransaction(TransactionManager &manager, ClientContext &context) : Transaction(manager, context) {
+	}
+};
+
+//! Nothing in a SiStat catalog changes within a transaction, so transactions only need to be tracked
+class SistatTransactionManager final : public TransactionManager {
+public:
+	explicit SistatTransactionManager(AttachedDatabase &db) : TransactionManager(db) {
+	}
+
+	Transaction &StartTransaction(ClientContext &context) override {
+		auto transaction = make_uniq<SistatTransaction>(*this, context);
+		auto &result = *transaction;
+		lock_guard<mutex> guard(transactions_lock);
+		transactions[result] = std::move(transaction);
+		return result;
+	}
+	ErrorData CommitTransaction(ClientContext &context, Transaction &transaction) override {
+		lock_guard<mutex> guard(transactions_lock);
+		transactions.erase(transaction);
+		return ErrorData();
+	}
+	void RollbackTransaction(Transaction &transaction) override {
+		lock_guard<mutex> guard(transactions_lock);
+		transactions.erase(transaction);
+	}
+	void Checkpoint(ClientContext &context, bool force) override {
+	}
+
+private:
+	mutex transactions_lock;
+	reference_map_t<Transaction, unique_ptr<Transaction>> transactions;
+};
+
+unique_ptr<Catalog> Attach(optional_ptr<StorageExtensionInfo> storage_info, ClientContext &context,
+                           AttachedDatabase &db, const string &name, AttachInfo &info, AttachOptions &options) {
+	string language = sistat::DEFAULT_LANGUAGE;
+	case_insensitive_set_t table_ids;
+	for (auto &option : options.options) {
+		auto option_name = StringUtil::Lower(option.first);
+		if (option.second.IsNull()) {
+			continue;
+		}
+		if (option_name == "language") {
+			language = option.second.ToString();
+		} else if (option_name == "tables") {
+			for (auto &table_id : StringUtil::Split(option.second.ToString(), ',')) {
+				StringUtil::Trim(table_id);
+				if (!table_id.empty()) {
+					table_ids.insert(sistat::NormalizeTableId(table_id));
+				}
+			}
+		} else {
+			throw BinderException("Unrecognized option for a SiStat catalog: \"%s\"", option.first);
+		}
+	}
+	if (language.empty()) {
+		language = sistat::DEFAULT_LANGUAGE;
+	}
+	return make_uniq<SistatCatalog>(db, info.path, sistat::BaseUrl(context), std::move(language),
+	                                std::move(table_ids));
+}
+
+unique_ptr<TransactionManager> CreateTransactionManager(optional_ptr<StorageExtensionInfo> storage_info,
+                                                        AttachedDatabase &db, Catalog &catalog) {
+	return make_uniq<SistatTransactionManager>(db);
+}
+
+} // namespace
+
+void SistatStorageExtension::Register(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	auto storage = make_uniq<StorageExtension>();
+	storage->attach = Attach;
+	storage->create_transaction_manager = CreateTransactionManager;
+	config.storage_extensions[CATALOG_TYPE] = std::move(storage);
+}
+
+} // namespace duckdb
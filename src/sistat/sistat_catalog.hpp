@@ -0,0 +1,12 @@
+#pragma once
+
+namespace duckdb {
+
+class ExtensionLoader;
+//! `ATTACH 'sistat' AS ss (TYPE sistat)`: a read-only catalog whose tables are the SiStat tables, scanned with
+//! SISTAT_Read
+struct SistatStorageExtension {
+	static void Register(ExtensionLoader &loader);
+};
+
+} // namespace duckdb
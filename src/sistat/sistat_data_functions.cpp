@@ -1,65 +1,361 @@
 #include "sistat_data_functions.hpp"
+#include "duckdb/catalog/catalog.hpp"
+#include "duckdb/catalog/catalog_entry/table_function_catalog_entry.hpp"
 #include "duckdb/main/client_context.hpp"
+#include "duckdb/main/extension_helper.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/parallel/task_scheduler.hpp"
 #include "duckdb/function/table_function.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/file_system.hpp"
 #include "duckdb/common/string_util.hpp"
+#include "duckdb/common/types/decimal.hpp"
+#include "duckdb/common/unordered_set.hpp"
+#include "duckdb/common/mutex.hpp"
+#include "duckdb/execution/physical_operator_states.hpp"
+#include "duckdb/parser/expression/constant_expression.hpp"
+#include "duckdb/parser/expression/function_expression.hpp"
+#include "duckdb/parser/tableref/table_function_ref.hpp"
+#include "duckdb/planner/expression/bound_columnref_expression.hpp"
+#include "duckdb/planner/expression/bound_comparison_expression.hpp"
+#include "duckdb/planner/expression/bound_conjunction_expression.hpp"
+#include "duckdb/planner/expression/bound_constant_expression.hpp"
+#include "duckdb/planner/expression/bound_operator_expression.hpp"
+#include "duckdb/planner/operator/logical_get.hpp"
+#include "duckdb/storage/buffer_manager.hpp"
+#include "duckdb/storage/statistics/base_statistics.hpp"
+#include "duckdb/storage/statistics/node_statistics.hpp"
+#include "duckdb/storage/statistics/string_stats.hpp"
 #include "yyjson.hpp"
 #include "sistat.hpp"
 #include "http_request.hpp"
+#include "json_stat.hpp"
+#include "metadata_cache.hpp"
+#include "mirror.hpp"
+#include "px_file.hpp"
+#include "response_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <functional>
 
 using duckdb_yyjson::yyjson_arr_get;
 using duckdb_yyjson::yyjson_arr_size;
 using duckdb_yyjson::yyjson_doc;
 using duckdb_yyjson::yyjson_doc_free;
 using duckdb_yyjson::yyjson_doc_get_root;
-using duckdb_yyjson::yyjson_get_num;
+using duckdb_yyjson::yyjson_get_bool;
 using duckdb_yyjson::yyjson_get_str;
 using duckdb_yyjson::yyjson_get_uint;
 using duckdb_yyjson::yyjson_is_arr;
-using duckdb_yyjson::yyjson_is_null;
-using duckdb_yyjson::yyjson_is_num;
 using duckdb_yyjson::yyjson_is_obj;
 using duckdb_yyjson::yyjson_is_str;
 using duckdb_yyjson::yyjson_is_uint;
+using duckdb_yyjson::yyjson_mut_arr_add_obj;
+using duckdb_yyjson::yyjson_mut_arr_add_strncpy;
+using duckdb_yyjson::yyjson_mut_doc;
+using duckdb_yyjson::yyjson_mut_doc_free;
+using duckdb_yyjson::yyjson_mut_doc_new;
+using duckdb_yyjson::yyjson_mut_doc_set_root;
+using duckdb_yyjson::yyjson_mut_obj;
+using duckdb_yyjson::yyjson_mut_obj_add_arr;
+using duckdb_yyjson::yyjson_mut_obj_add_obj;
+using duckdb_yyjson::yyjson_mut_obj_add_str;
+using duckdb_yyjson::yyjson_mut_obj_add_strncpy;
+using duckdb_yyjson::yyjson_mut_val;
+using duckdb_yyjson::yyjson_mut_write;
 using duckdb_yyjson::yyjson_obj_get;
 using duckdb_yyjson::yyjson_read;
 using duckdb_yyjson::yyjson_val;
+using duckdb_yyjson::YYJSON_WRITE_NOFLAG;
 
 namespace duckdb {
 
 namespace {
 
-static bool IsStatisticalSymbol(const string &s) {
-	if (s.empty()) {
-		return true;
-	}
-	if (s == "-" || s == "..." || s == "z" || s == "M" || s == "N") {
-		return true;
-	}
-	return false;
-}
-
 struct SISTAT_Read_Impl {
 
+	//! Largest decimal scale that still leaves room for integer digits in a DECIMAL(18, s) value
+	static constexpr idx_t MAX_VALUE_DECIMALS = 9;
+	//! Number of cells handed to a scanning thread at a time
+	static constexpr idx_t MORSEL_SIZE = 16 * STANDARD_VECTOR_SIZE;
+	//! Requests of at least this many cells ask for PX rather than json-stat when the format is automatic
+	static constexpr idx_t PX_FORMAT_MIN_CELLS = 50000;
+	//! How long a scan waits for a scheduler thread to pick up a download it needs before running it itself
+	static constexpr int64_t CLAIM_WAIT_MS = 10;
+
+	//! Values of one dimension requested from the server; all values when not filtered
+	struct DimensionSelection {
+		bool filtered = false;
+		vector<string> codes;
+	};
+
+	//! Cube that SISTAT_ReadFile decoded during binding; the first execution takes it over
+	struct BoundCube {
+		mutex lock;
+		bool taken = false;
+		JsonStatCube cube;
+
+		//! False when another execution already took the cube
+		bool TryTake(JsonStatCube &result) {
+			lock_guard<mutex> guard(lock);
+			if (taken) {
+				return false;
+			}
+			taken = true;
+			result = std::move(cube);
+			return true;
+		}
+	};
+
+	//! A downloaded cube with the dictionaries its dimension and status columns are emitted from
+	struct DecodedCube {
+		JsonStatCube cube;
+		//! Codes of each cube dimension; dimension columns are emitted as selections into these
+		vector<Vector> dictionaries;
+		//! Status symbols, preceded by a NULL entry for cells without a status. Shared, as a streamed cube replaces it
+		//! when new symbols arrive while earlier chunks still reference the old one.
+		shared_ptr<Vector> status_dictionary;
+		idx_t status_dictionary_size = 0;
+
+		void BuildDictionaries() {
+			BuildStatusDictionary();
+			dictionaries.clear();
+			for (auto &codes : cube.codes_per_dim) {
+				dictionaries.emplace_back(LogicalType::VARCHAR, MaxValue<idx_t>(codes.size(), 1));
+				auto &dictionary = dictionaries.back();
+				auto data = FlatVector::GetData<string_t>(dictionary);
+				for (idx_t i = 0; i < codes.size(); i++) {
+					data[i] = StringVector::AddString(dictionary, codes[i]);
+				}
+			}
+		}
+
+		//! (Re)build the status dictionary if symbols were added since it was last built
+		void BuildStatusDictionary() {
+			if (status_dictionary && status_dictionary_size == cube.statuses.size()) {
+				return;
+			}
+			status_dictionary = make_shared_ptr<Vector>(LogicalType::VARCHAR, cube.statuses.size() + 1);
+			FlatVector::SetNull(*status_dictionary, 0, true);
+			for (idx_t i = 0; i < cube.statuses.size(); i++) {
+				FlatVector::GetData<string_t>(*status_dictionary)[i + 1] =
+				    StringVector::AddString(*status_dictionary, cube.statuses[i]);
+			}
+			status_dictionary_size = cube.statuses.size();
+		}
+
+		void WriteDimension(idx_t dim, idx_t start, idx_t count, Vector &vec) {
+			auto &dictionary = dictionaries[dim];
+			auto stride = cube.strides[dim];
+			if (start / stride == (start + count - 1) / stride) {
+				// The whole chunk lies within one position of this dimension
+				ConstantVector::Reference(vec, dictionary, cube.CodeIndex(dim, start), count);
+				return;
+			}
+			SelectionVector sel(count);
+			for (idx_t i = 0; i < count; i++) {
+				sel.set_index(i, cube.CodeIndex(dim, start + i));
+			}
+			vec.Slice(dictionary, sel, count);
+		}
+
+		void WriteStatus(idx_t start, idx_t count, Vector &vec) {
+			WriteStatus(*status_dictionary, start, count, vec);
+		}
+
+		void WriteStatus(const Vector &dictionary, idx_t start, idx_t count, Vector &vec) {
+			SelectionVector sel(count);
+			for (idx_t i = 0; i < count; i++) {
+				sel.set_index(i, cube.status_ids[start + i]);
+			}
+			vec.Slice(dictionary, sel, count);
+		}
+	};
+
+	//! Download whose cells are emitted while the rest of the response is still being decoded. It runs as a task on
+	//! the database's scheduler, which shares it, so a task that only starts after the scan ended does nothing.
+	struct CubeStream {
+		//! Filled as the body arrives; read by the scan up to `cells_ready`
+		DecodedCube decoded;
+		mutex lock;
+		std::condition_variable changed;
+		//! Set once the cube has its layout and dimension dictionaries
+		bool started = false;
+		//! Leading cells that are decoded and may be emitted
+		idx_t cells_ready = 0;
+		bool finished = false;
+		std::exception_ptr error;
+		//! Ends the transfer when the scan stops early, including waits for pacing or backoff and stalled reads
+		shared_ptr<HttpCancellation> cancellation;
+		//! Set by the thread that runs the download, or by its owner to keep it from ever running
+		atomic<bool> claimed {false};
+		std::function<void()> download;
+		unique_ptr<ProducerToken> token;
+
+		//! Run the download unless another thread already took it
+		void TryRun() {
+			if (!claimed.exchange(true)) {
+				download();
+			}
+		}
+
+		//! Cancel the download and wait for it to return
+		void Stop() {
+			cancellation->Cancel();
+			if (!claimed.exchange(true)) {
+				// Never started, and now never will
+				return;
+			}
+			unique_lock<mutex> guard(lock);
+			changed.wait(guard, [&]() { return finished; });
+		}
+	};
+
+	class StreamTask final : public Task {
+	public:
+		explicit StreamTask(shared_ptr<CubeStream> stream_p) : stream(std::move(stream_p)) {
+		}
+
+		TaskExecutionResult Execute(TaskExecutionMode mode) override {
+			stream->TryRun();
+			return TaskExecutionResult::TASK_FINISHED;
+		}
+
+	private:
+		shared_ptr<CubeStream> stream;
+	};
+
+	//! Download of the whole cube that Bind starts for a read without filters, so the request overlaps planning
+	//! instead of following it. The first execution whose request body matches adopts the stream; when none does,
+	//! for DESCRIBE or a PREPARE that is never executed, the bind data cancels it on destruction.
+	struct BoundDownload {
+		BoundDownload(string body_p, shared_ptr<CubeStream> stream_p)
+		    : body(std::move(body_p)), stream(std::move(stream_p)) {
+		}
+		~BoundDownload() {
+			Cancel();
+		}
+
+		//! The stream when it downloads `request_body` and no execution took it yet
+		shared_ptr<CubeStream> TryAdopt(const string &request_body) {
+			lock_guard<mutex> guard(lock);
+			if (!stream || request_body != body) {
+				return nullptr;
+			}
+			return std::move(stream);
+		}
+
+		//! Stop a download that no execution took
+		void Cancel() {
+			shared_ptr<CubeStream> abandoned;
+			{
+				lock_guard<mutex> guard(lock);
+				abandoned = std::move(stream);
+			}
+			if (abandoned) {
+				abandoned->Stop();
+			}
+		}
+
+		const string body;
+
+	private:
+		mutex lock;
+		shared_ptr<CubeStream> stream;
+	};
+
 	struct BindData final : TableFunctionData {
 		string table_id;
 		string table_url;
 		string language;
 		vector<string> dimension_names;
-		BindData(string table_id_p, string table_url_p, string language_p, vector<string> dimension_names_p)
+		//! Variable texts, which PX responses use in place of codes
+		vector<string> dimension_texts;
+		//! Value codes of each dimension as listed in the table metadata
+		vector<vector<string>> dimension_codes;
+		//! Whether the server may aggregate a dimension away when it is left out of the query
+		vector<bool> eliminable;
+		//! Ask the server to eliminate eliminable dimensions that the query does not reference
+		bool eliminate_unused = false;
+		//! Response format requested from the server: auto, json-stat, json-stat2 or px
+		string format = "auto";
+		//! DOUBLE, or DECIMAL when the metadata declares the number of decimals
+		LogicalType value_type = LogicalType::DOUBLE;
+		//! Selections derived from pushed-down filters, one per dimension
+		vector<DimensionSelection> selections;
+		//! Set when the pushed-down filters cannot match any value
+		bool empty_selection = false;
+		//! Set when the cube was already decoded during binding
+		shared_ptr<BoundCube> bound_cube;
+		//! Set when binding started downloading the whole cube
+		shared_ptr<BoundDownload> bound_download;
+		//! Requests and decoding while binding: the metadata lookup, or the decode of a json-stat file
+		shared_ptr<SistatStats> stats = make_shared_ptr<SistatStats>();
+		BindData(string table_id_p, string table_url_p, string language_p, vector<string> dimension_names_p,
+		         vector<vector<string>> dimension_codes_p, vector<bool> eliminable_p)
 		    : table_id(std::move(table_id_p)), table_url(std::move(table_url_p)), language(std::move(language_p)),
-		      dimension_names(std::move(dimension_names_p)) {
+		      dimension_names(std::move(dimension_names_p)), dimension_codes(std::move(dimension_codes_p)),
+		      eliminable(std::move(eliminable_p)), selections(dimension_names.size()) {
 		}
-	};
 
-	struct DataRow {
-		vector<string> dimension_values;
-		string value;
+		//! Restrict a dimension to the given codes, keeping metadata order and dropping unknown codes
+		void Select(idx_t dim_idx, const unordered_set<string> &codes) {
+			auto &selection = selections[dim_idx];
+			vector<string> selected;
+			for (auto &code : selection.filtered ? selection.codes : dimension_codes[dim_idx]) {
+				if (codes.find(code) != codes.end()) {
+					selected.push_back(code);
+				}
+			}
+			selection.filtered = true;
+			selection.codes = std::move(selected);
+			if (selection.codes.empty()) {
+				empty_selection = true;
+			}
+		}
 	};
 
 	struct State final : GlobalTableFunctionState {
-		vector<DataRow> rows;
-		idx_t current_row = 0;
+		~State() override {
+			// A LIMIT may end the scan while the body is still arriving; the transfer is cancelled rather than awaited
+			if (stream) {
+				stream->Stop();
+			}
+		}
+
+		//! Projected columns, in output order
+		vector<column_t> column_ids;
+		//! Cube dimension of each dimension column; invalid when the server eliminated it
+		vector<optional_idx> cube_dims;
+		//! The cube when it was read before the scan started
+		DecodedCube decoded;
+		//! Set instead when the cube is filled by a download that may still be in progress
+		shared_ptr<CubeStream> stream;
+		//! Next morsel of cells to hand out to a scanning thread
+		atomic<idx_t> next_morsel {0};
+		//! Requests and decoding of this execution; a prepared statement binds once but runs Init every time
+		shared_ptr<SistatStats> stats = make_shared_ptr<SistatStats>();
+
+		DecodedCube &Decoded() {
+			return stream ? stream->decoded : decoded;
+		}
+
+		idx_t MaxThreads() const override {
+			auto cells = stream ? stream->decoded.cube.CellCount() : decoded.cube.CellCount();
+			return MaxValue<idx_t>((cells + MORSEL_SIZE - 1) / MORSEL_SIZE, 1);
+		}
+	};
+
+	struct LocalState final : LocalTableFunctionState {
+		//! Morsel being scanned, used as the batch index to preserve insertion order
+		idx_t morsel = 0;
+		idx_t position = 0;
+		idx_t end = 0;
 	};
 
 	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
@@ -73,29 +369,107 @@ struct SISTAT_Read_Impl {
 			throw InvalidInputException("SISTAT_Read: table_id cannot be empty.");
 		}
 
-		string lang = sistat::DEFAULT_LANGUAGE;
-		auto it = input.named_parameters.find("language");
-		if (it != input.named_parameters.end() && !it->second.IsNull() && it->second.type() == LogicalType::VARCHAR) {
-			lang = it->second.GetValue<string>();
+		string lang = GetLanguage(input.named_parameters);
+		bool eliminate_unused = GetEliminateUnused(input.named_parameters);
+		string format = GetFormat(input.named_parameters, "SISTAT_Read");
+
+		string normalized_id = sistat::NormalizeTableId(table_id);
+		string table_url = sistat::TableUrl(sistat::BaseUrl(context), lang, normalized_id);
+
+		auto stats = make_shared_ptr<SistatStats>();
+		auto lookup = MetadataCache::CreateLookup(context, table_url);
+		lookup.settings.stats.call = stats;
+		string metadata = lookup.Get(table_url, "SISTAT_Read");
+		auto result = BindTable(metadata, normalized_id, table_url, lang, std::move(stats), return_types, names);
+		result->eliminate_unused = eliminate_unused;
+		result->format = std::move(format);
+		if (Prefetch(context)) {
+			StartBoundDownload(context, *result);
 		}
-		if (lang.empty()) {
-			lang = sistat::DEFAULT_LANGUAGE;
+		return std::move(result);
+	}
+
+	//! Bind data and result columns of a table, from its metadata
+	static unique_ptr<BindData> BindTable(const string &metadata, const string &normalized_id, const string &table_url,
+	                                      const string &lang, shared_ptr<SistatStats> stats,
+	                                      vector<LogicalType> &return_types, vector<string> &names) {
+		auto result = ParseMetadata(metadata, normalized_id, table_url, lang);
+		result->stats = std::move(stats);
+		for (const auto &name : result->dimension_names) {
+			names.emplace_back(name);
+			return_types.push_back(LogicalType::VARCHAR);
 		}
+		names.emplace_back("value");
+		return_types.push_back(result->value_type);
+		names.emplace_back("status");
+		return_types.push_back(LogicalType::VARCHAR);
+		return result;
+	}
 
-		string normalized_id = sistat::NormalizeTableId(table_id);
-		string table_url = sistat::TableUrl(lang, normalized_id);
+	static string GetLanguage(const named_parameter_map_t &named_parameters) {
+		auto it = named_parameters.find("language");
+		if (it != named_parameters.end() && !it->second.IsNull() && it->second.type() == LogicalType::VARCHAR &&
+		    !StringValue::Get(it->second).empty()) {
+			return StringValue::Get(it->second);
+		}
+		return sistat::DEFAULT_LANGUAGE;
+	}
 
-		HttpSettings settings = HttpRequest::ExtractHttpSettings(context, table_url);
-		HttpResponseData resp = HttpRequest::ExecuteHttpRequest(settings, table_url, "GET", {}, "", "");
+	static bool GetEliminateUnused(const named_parameter_map_t &named_parameters) {
+		auto it = named_parameters.find("eliminate_unused");
+		return it != named_parameters.end() && !it->second.IsNull() && BooleanValue::Get(it->second);
+	}
 
-		if (!resp.error.empty()) {
-			throw IOException("SISTAT_Read: %s", resp.error.c_str());
+	//! Parquet file of a (normalized) table id in the configured mirror; empty when there is none
+	static string SnapshotPath(ClientContext &context, const string &table_id, const string &lang) {
+		auto directory = SistatMirror::Directory(context);
+		if (directory.empty()) {
+			return string();
 		}
-		if (resp.status_code != 200) {
-			throw IOException("SISTAT_Read: HTTP %d - %s", resp.status_code, resp.body.c_str());
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto path = SistatMirror::DataPath(fs, directory, table_id, lang);
+		return fs.FileExists(path) ? path : string();
+	}
+
+	//! Scan the table's snapshot when a mirror is configured and has one; otherwise bind normally and download it.
+	//! The snapshot holds the same columns, and Parquet pushes filters and projections down by itself. Eliminating
+	//! dimensions needs the server's aggregates, so such reads always go to the server.
+	static unique_ptr<TableRef> BindReplace(ClientContext &context, TableFunctionBindInput &input) {
+		if (input.inputs.empty() || input.inputs[0].IsNull() || GetEliminateUnused(input.named_parameters)) {
+			return nullptr;
 		}
+		// An invalid format fails the same way with or without a snapshot
+		GetFormat(input.named_parameters, "SISTAT_Read");
+		auto table_id = sistat::NormalizeTableId(StringValue::Get(input.inputs[0]));
+		auto path = SnapshotPath(context, table_id, GetLanguage(input.named_parameters));
+		if (path.empty()) {
+			return nullptr;
+		}
+		vector<unique_ptr<ParsedExpression>> children;
+		children.push_back(make_uniq<ConstantExpression>(Value(path)));
+		auto result = make_uniq<TableFunctionRef>();
+		result->function = make_uniq<FunctionExpression>("read_parquet", std::move(children));
+		return std::move(result);
+	}
 
-		yyjson_doc *doc = yyjson_read(resp.body.c_str(), resp.body.size(), 0);
+	//! The `format` named parameter, validated
+	static string GetFormat(const named_parameter_map_t &named_parameters, const string &function_name) {
+		auto it = named_parameters.find("format");
+		if (it == named_parameters.end() || it->second.IsNull()) {
+			return "auto";
+		}
+		auto format = StringUtil::Lower(StringValue::Get(it->second));
+		if (format != "auto" && format != "json-stat" && format != "json-stat2" && format != "px") {
+			throw InvalidInputException("%s: format must be one of 'auto', 'json-stat', 'json-stat2' or 'px', got '%s'",
+			                            function_name, format);
+		}
+		return format;
+	}
+
+	//! Dimensions, value codes and value type of a table, from its metadata JSON
+	static unique_ptr<BindData> ParseMetadata(const string &metadata, const string &normalized_id,
+	                                          const string &table_url, const string &lang) {
+		yyjson_doc *doc = yyjson_read(metadata.c_str(), metadata.size(), 0);
 		if (!doc) {
 			throw IOException("SISTAT_Read: Invalid metadata JSON");
 		}
@@ -108,6 +482,9 @@ struct SISTAT_Read_Impl {
 		}
 
 		vector<string> dimension_names;
+		vector<string> dimension_texts;
+		vector<vector<string>> dimension_codes;
+		vector<bool> eliminable;
 		size_t n_var = yyjson_arr_size(variables);
 		for (size_t i = 0; i < n_var; i++) {
 			yyjson_val *var_obj = yyjson_arr_get(variables, i);
@@ -115,37 +492,376 @@ struct SISTAT_Read_Impl {
 				continue;
 			}
 			yyjson_val *code_val = yyjson_obj_get(var_obj, "code");
-			if (yyjson_is_str(code_val)) {
-				dimension_names.push_back(yyjson_get_str(code_val));
+			if (!yyjson_is_str(code_val)) {
+				continue;
 			}
+			dimension_names.push_back(yyjson_get_str(code_val));
+			yyjson_val *text_val = yyjson_obj_get(var_obj, "text");
+			dimension_texts.push_back(yyjson_is_str(text_val) ? yyjson_get_str(text_val) : dimension_names.back());
+			eliminable.push_back(yyjson_get_bool(yyjson_obj_get(var_obj, "elimination")));
+
+			vector<string> codes;
+			yyjson_val *values = yyjson_obj_get(var_obj, "values");
+			if (yyjson_is_arr(values)) {
+				size_t arr_idx, arr_max;
+				yyjson_val *code = nullptr;
+				yyjson_arr_foreach(values, arr_idx, arr_max, code) {
+					if (yyjson_is_str(code)) {
+						codes.push_back(yyjson_get_str(code));
+					}
+				}
+			}
+			dimension_codes.push_back(std::move(codes));
+		}
+		LogicalType value_type = LogicalType::DOUBLE;
+		yyjson_val *decimals = yyjson_obj_get(root, "decimals");
+		if (yyjson_is_uint(decimals) && yyjson_get_uint(decimals) <= MAX_VALUE_DECIMALS) {
+			auto scale = static_cast<uint8_t>(yyjson_get_uint(decimals));
+			value_type = LogicalType::DECIMAL(Decimal::MAX_WIDTH_INT64, scale);
 		}
 		yyjson_doc_free(doc);
 
-		for (const auto &name : dimension_names) {
-			names.emplace_back(name);
-			return_types.push_back(LogicalType::VARCHAR);
+		auto result = make_uniq<BindData>(normalized_id, table_url, lang, std::move(dimension_names),
+		                                  std::move(dimension_codes), std::move(eliminable));
+		result->dimension_texts = std::move(dimension_texts);
+		result->value_type = value_type;
+		return result;
+	}
+
+	//! Resolve a column reference of this scan to a dimension index
+	static bool TryGetDimension(const Expression &expr, LogicalGet &get, const BindData &bind_data, idx_t &dim_idx) {
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_COLUMN_REF) {
+			return false;
 		}
-		names.emplace_back("value");
-		return_types.push_back(LogicalType::VARCHAR);
+		auto &colref = expr.Cast<BoundColumnRefExpression>();
+		if (colref.depth > 0 || colref.binding.table_index != get.table_index) {
+			return false;
+		}
+		auto &column_ids = get.GetColumnIds();
+		if (colref.binding.column_index >= column_ids.size()) {
+			return false;
+		}
+		auto &column_index = column_ids[colref.binding.column_index];
+		if (column_index.IsRowIdColumn() || column_index.GetPrimaryIndex() >= bind_data.dimension_names.size()) {
+			return false;
+		}
+		dim_idx = column_index.GetPrimaryIndex();
+		return true;
+	}
 
-		return make_uniq_base<FunctionData, BindData>(normalized_id, table_url, lang, dimension_names);
+	static bool TryGetCode(const Expression &expr, string &code) {
+		if (expr.GetExpressionClass() != ExpressionClass::BOUND_CONSTANT) {
+			return false;
+		}
+		auto &constant = expr.Cast<BoundConstantExpression>();
+		if (constant.value.IsNull() || constant.value.type().id() != LogicalTypeId::VARCHAR) {
+			return false;
+		}
+		code = StringValue::Get(constant.value);
+		return true;
 	}
 
-	static string BuildQueryJson() {
-		return "{\"query\":[],\"response\":{\"format\":\"json-stat\"}}";
+	//! Match `dim = 'x'`, `dim IN ('x', 'y')` and OR-chains of those on a single dimension
+	static bool TryExtractSelection(const Expression &expr, LogicalGet &get, const BindData &bind_data, idx_t &dim_idx,
+	                                unordered_set<string> &codes) {
+		string code;
+		switch (expr.GetExpressionType()) {
+		case ExpressionType::COMPARE_EQUAL: {
+			auto &comparison = expr.Cast<BoundComparisonExpression>();
+			if (TryGetDimension(*comparison.left, get, bind_data, dim_idx) && TryGetCode(*comparison.right, code)) {
+				codes.insert(code);
+				return true;
+			}
+			if (TryGetDimension(*comparison.right, get, bind_data, dim_idx) && TryGetCode(*comparison.left, code)) {
+				codes.insert(code);
+				return true;
+			}
+			return false;
+		}
+		case ExpressionType::COMPARE_IN: {
+			auto &op = expr.Cast<BoundOperatorExpression>();
+			if (op.children.size() < 2 || !TryGetDimension(*op.children[0], get, bind_data, dim_idx)) {
+				return false;
+			}
+			for (idx_t i = 1; i < op.children.size(); i++) {
+				if (!TryGetCode(*op.children[i], code)) {
+					return false;
+				}
+				codes.insert(code);
+			}
+			return true;
+		}
+		case ExpressionType::CONJUNCTION_OR: {
+			auto &conjunction = expr.Cast<BoundConjunctionExpression>();
+			optional_idx or_dim;
+			for (auto &child : conjunction.children) {
+				idx_t child_dim;
+				if (!TryExtractSelection(*child, get, bind_data, child_dim, codes)) {
+					return false;
+				}
+				if (or_dim.IsValid() && or_dim.GetIndex() != child_dim) {
+					return false;
+				}
+				or_dim = child_dim;
+			}
+			if (!or_dim.IsValid()) {
+				return false;
+			}
+			dim_idx = or_dim.GetIndex();
+			return true;
+		}
+		default:
+			return false;
+		}
 	}
 
-	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+	static void PushdownComplexFilter(ClientContext &context, LogicalGet &get, FunctionData *bind_data_p,
+	                                  vector<unique_ptr<Expression>> &filters) {
 
-		auto &bind_data = input.bind_data->Cast<BindData>();
-		auto state = make_uniq_base<GlobalTableFunctionState, State>();
-		State *state_ptr = static_cast<State *>(state.get());
+		auto &bind_data = bind_data_p->Cast<BindData>();
+		for (idx_t i = 0; i < filters.size();) {
+			idx_t dim_idx;
+			unordered_set<string> codes;
+			if (!TryExtractSelection(*filters[i], get, bind_data, dim_idx, codes)) {
+				i++;
+				continue;
+			}
+			// The server only returns the selected values, so the filter is fully handled here
+			bind_data.Select(dim_idx, codes);
+			filters.erase_at(i);
+		}
+	}
 
-		string body = BuildQueryJson();
-		HttpSettings settings = HttpRequest::ExtractHttpSettings(context, bind_data.table_url);
+	//! Dimensions to leave out of the query so the server aggregates them away
+	static vector<bool> EliminatedDimensions(const BindData &bind_data, const vector<column_t> &column_ids) {
+		idx_t num_dim = bind_data.dimension_names.size();
+		vector<bool> eliminated(num_dim, false);
+		if (!bind_data.eliminate_unused) {
+			return eliminated;
+		}
+		vector<bool> referenced(num_dim, false);
+		for (auto column_id : column_ids) {
+			if (column_id < num_dim) {
+				referenced[column_id] = true;
+			}
+		}
+		optional_idx kept;
+		for (idx_t d = 0; d < num_dim; d++) {
+			eliminated[d] = bind_data.eliminable[d] && !referenced[d] && !bind_data.selections[d].filtered;
+			if (!eliminated[d]) {
+				kept = d;
+			}
+		}
+		if (!kept.IsValid() && num_dim > 0) {
+			// An empty query means "everything", so keep the smallest dimension in the request
+			idx_t smallest = 0;
+			for (idx_t d = 1; d < num_dim; d++) {
+				if (bind_data.dimension_codes[d].size() < bind_data.dimension_codes[smallest].size()) {
+					smallest = d;
+				}
+			}
+			eliminated[smallest] = false;
+		}
+		return eliminated;
+	}
+
+	static idx_t SelectionSize(const BindData &bind_data, const vector<DimensionSelection> &selections, idx_t d) {
+		return selections[d].filtered ? selections[d].codes.size() : bind_data.dimension_codes[d].size();
+	}
+
+	//! Split a request along its largest dimension until every part stays within the server's cell limit
+	static void SplitRequest(const BindData &bind_data, vector<DimensionSelection> selections,
+	                         const vector<bool> &eliminated, idx_t max_cells,
+	                         vector<vector<DimensionSelection>> &result) {
+		idx_t total_cells = 1;
+		optional_idx largest;
+		idx_t largest_size = 1;
+		for (idx_t d = 0; d < selections.size(); d++) {
+			if (eliminated[d]) {
+				continue;
+			}
+			idx_t size = SelectionSize(bind_data, selections, d);
+			total_cells *= size;
+			if (size > largest_size) {
+				largest = d;
+				largest_size = size;
+			}
+		}
+		if (total_cells <= max_cells || !largest.IsValid()) {
+			result.push_back(std::move(selections));
+			return;
+		}
+		idx_t dim = largest.GetIndex();
+		vector<string> codes = selections[dim].filtered ? selections[dim].codes : bind_data.dimension_codes[dim];
+		idx_t codes_per_part = MaxValue<idx_t>(max_cells / (total_cells / largest_size), 1);
+		for (idx_t offset = 0; offset < codes.size(); offset += codes_per_part) {
+			auto part = selections;
+			part[dim].filtered = true;
+			auto part_end = MinValue(offset + codes_per_part, codes.size());
+			part[dim].codes.assign(codes.begin() + static_cast<int64_t>(offset),
+			                       codes.begin() + static_cast<int64_t>(part_end));
+			// Parts that are still too large (one code of this dimension is over the limit) split further
+			SplitRequest(bind_data, std::move(part), eliminated, max_cells, result);
+		}
+	}
+
+	//! Response format for one request. PX is a flat text format that is smaller and cheaper to decode than json-stat,
+	//! so automatic selection uses it for large requests.
+	static const char *ResponseFormat(const BindData &bind_data, const vector<DimensionSelection> &selections,
+	                                  const vector<bool> &eliminated) {
+		if (bind_data.format != "auto") {
+			return bind_data.format.c_str();
+		}
+		idx_t cells = 1;
+		for (idx_t d = 0; d < selections.size(); d++) {
+			if (!eliminated[d]) {
+				cells *= SelectionSize(bind_data, selections, d);
+			}
+		}
+		return cells >= PX_FORMAT_MIN_CELLS ? "px" : "json-stat";
+	}
+
+	static string BuildQueryJson(const BindData &bind_data, const vector<DimensionSelection> &selections,
+	                             const vector<bool> &eliminated) {
+		yyjson_mut_doc *doc = yyjson_mut_doc_new(nullptr);
+		yyjson_mut_val *root = yyjson_mut_obj(doc);
+		yyjson_mut_doc_set_root(doc, root);
+
+		// An empty query returns the whole cube; once any dimension is filtered or eliminated, every requested
+		// dimension has to be listed explicitly because PxWeb eliminates the variables that are left out
+		bool explicit_query = false;
+		for (idx_t d = 0; d < bind_data.dimension_names.size(); d++) {
+			explicit_query = explicit_query || selections[d].filtered || eliminated[d];
+		}
+		yyjson_mut_val *query = yyjson_mut_obj_add_arr(doc, root, "query");
+		for (idx_t d = 0; explicit_query && d < bind_data.dimension_names.size(); d++) {
+			if (eliminated[d]) {
+				continue;
+			}
+			auto &selection = selections[d];
+			auto &name = bind_data.dimension_names[d];
+			yyjson_mut_val *entry = yyjson_mut_arr_add_obj(doc, query);
+			yyjson_mut_obj_add_strncpy(doc, entry, "code", name.c_str(), name.size());
+			yyjson_mut_val *sel = yyjson_mut_obj_add_obj(doc, entry, "selection");
+			yyjson_mut_obj_add_str(doc, sel, "filter", selection.filtered ? "item" : "all");
+			yyjson_mut_val *values = yyjson_mut_obj_add_arr(doc, sel, "values");
+			if (!selection.filtered) {
+				yyjson_mut_arr_add_strncpy(doc, values, "*", 1);
+				continue;
+			}
+			for (auto &code : selection.codes) {
+				yyjson_mut_arr_add_strncpy(doc, values, code.c_str(), code.size());
+			}
+		}
+		yyjson_mut_val *response = yyjson_mut_obj_add_obj(doc, root, "response");
+		yyjson_mut_obj_add_str(doc, response, "format", ResponseFormat(bind_data, selections, eliminated));
+
+		size_t len = 0;
+		char *json = yyjson_mut_write(doc, YYJSON_WRITE_NOFLAG, &len);
+		yyjson_mut_doc_free(doc);
+		if (!json) {
+			throw InternalException("SISTAT_Read: failed to serialize query");
+		}
+		string result(json, len);
+		free(json);
+		return result;
+	}
+
+	//! Decodes a response body as it downloads: PX incrementally, json-stat (which needs the whole document) once it
+	//! is complete. The format is recognized by the leading brace of json-stat.
+	class ResponseDecoder {
+	public:
+		ResponseDecoder(Allocator &allocator_p, JsonStatCube &cube_p, const vector<string> &dimension_names,
+		                const vector<string> &dimension_texts, StatsRecorder stats_p)
+		    : allocator(allocator_p), cube(cube_p), px(allocator_p, cube_p, dimension_names, dimension_texts),
+		      stats(std::move(stats_p)) {
+		}
+
+		void Feed(const char *data, idx_t size) {
+			if (!sniffed) {
+				idx_t first = 0;
+				while (first < size && StringUtil::CharacterIsSpace(data[first])) {
+					first++;
+				}
+				if (first == size) {
+					return;
+				}
+				is_json = data[first] == '{';
+				sniffed = true;
+			}
+			if (is_json) {
+				AppendJson(data, size);
+			} else {
+				auto start = std::chrono::steady_clock::now();
+				px.Feed(data, size);
+				stats.Add(&SistatStats::decode_us, StatsRecorder::MicrosSince(start));
+			}
+		}
+
+		void Finish() {
+			auto start = std::chrono::steady_clock::now();
+			uint64_t parse_us = 0;
+			if (is_json) {
+				cube = JsonStat::Parse(const_char_ptr_cast(json.get()), json_size, allocator, &parse_us);
+				json.Reset();
+			} else {
+				px.Finish();
+			}
+			complete = true;
+			stats.Add(&SistatStats::parse_us, parse_us);
+			stats.Add(&SistatStats::decode_us, StatsRecorder::MicrosSince(start) - parse_us);
+			stats.Add(&SistatStats::cells_decoded, cube.CellCount());
+		}
+
+		//! Whether the cube has its layout
+		bool Started() const {
+			return is_json ? complete : px.Started();
+		}
+		//! Number of leading cells that are final
+		idx_t CellsDecoded() const {
+			if (is_json) {
+				return complete ? cube.CellCount() : 0;
+			}
+			return px.CellsDecoded();
+		}
+
+	private:
+		//! Buffer the document in blocks from the allocator, doubling as it grows
+		void AppendJson(const char *data, idx_t size) {
+			if (json_size + size > json.GetSize()) {
+				auto grown = allocator.Allocate(NextPowerOfTwo(json_size + size));
+				if (json_size > 0) {
+					memcpy(grown.get(), json.get(), json_size);
+				}
+				json = std::move(grown);
+			}
+			memcpy(json.get() + json_size, data, size);
+			json_size += size;
+		}
+
+		Allocator &allocator;
+		JsonStatCube &cube;
+		PxStreamDecoder px;
+		StatsRecorder stats;
+		AllocatedData json;
+		idx_t json_size = 0;
+		bool sniffed = false;
+		bool is_json = false;
+		bool complete = false;
+	};
+
+	//! POST a query and hand the response body to `receiver`: streamed while it downloads, or in one piece when it
+	//! comes from the response cache. A broken transfer is only retried if `restart` can undo what was received.
+	static void ReceiveCube(const HttpSettings &settings, const string &table_url, const string &body,
+	                        const HttpBodyReceiver &receiver, const HttpBodyRestart &restart = nullptr) {
 		duckdb_httplib_openssl::Headers headers;
-		HttpResponseData resp =
-		    HttpRequest::ExecuteHttpRequest(settings, bind_data.table_url, "POST", headers, body, "application/json");
+		HttpResponseData resp;
+		if (settings.use_cache) {
+			resp = ResponseCache::ExecuteRequest(settings, table_url, "POST", headers, body, "application/json");
+		} else {
+			resp = HttpRequest::ExecuteStreamingRequest(settings, table_url, "POST", headers, body,
+			                                            "application/json", receiver, restart);
+		}
 
 		if (!resp.error.empty()) {
 			throw IOException("SISTAT_Read: %s", resp.error.c_str());
@@ -153,167 +869,944 @@ struct SISTAT_Read_Impl {
 		if (resp.status_code != 200) {
 			throw IOException("SISTAT_Read: HTTP %d - %s", resp.status_code, resp.body.c_str());
 		}
+		if (settings.use_cache) {
+			receiver(resp.body.data(), resp.body.size());
+		}
+	}
 
-		yyjson_doc *doc = yyjson_read(resp.body.c_str(), resp.body.size(), 0);
-		if (!doc) {
-			throw IOException("SISTAT_Read: Invalid JSON-stat response");
+	static JsonStatCube FetchCube(Allocator &allocator, const HttpSettings &settings, const string &table_url,
+	                              const string &body, const vector<string> &dimension_names,
+	                              const vector<string> &dimension_texts) {
+		JsonStatCube cube;
+		auto decoder = make_uniq<ResponseDecoder>(allocator, cube, dimension_names, dimension_texts, settings.stats);
+		auto receiver = [&](const char *data, idx_t size) {
+			decoder->Feed(data, size);
+			return true;
+		};
+		auto restart = [&]() {
+			// Nothing was emitted from the cube yet, so a broken transfer starts over on an empty one
+			decoder.reset();
+			cube = JsonStatCube();
+			decoder = make_uniq<ResponseDecoder>(allocator, cube, dimension_names, dimension_texts, settings.stats);
+		};
+		ReceiveCube(settings, table_url, body, receiver, restart);
+		decoder->Finish();
+		return cube;
+	}
+
+	//! Make the cells decoded so far visible to the scan; called with the stream lock held
+	static void PublishCells(CubeStream &stream, DecodedCube &decoded, const ResponseDecoder &decoder) {
+		if (!stream.started && decoder.Started()) {
+			decoded.BuildDictionaries();
+			stream.started = true;
 		}
+		stream.cells_ready = decoder.CellsDecoded();
+	}
 
-		yyjson_val *root = yyjson_doc_get_root(doc);
-		yyjson_val *dataset = yyjson_is_obj(root) ? yyjson_obj_get(root, "dataset") : nullptr;
-		if (!yyjson_is_obj(dataset)) {
-			yyjson_doc_free(doc);
-			throw IOException("SISTAT_Read: Expected root object with 'dataset'");
+	//! Produces a response body piece by piece: the download of a query, or a local file for SISTAT_ReadFile
+	typedef std::function<void(const HttpBodyReceiver &receiver)> CubeSource;
+
+	static void StreamCube(CubeStream &stream, Allocator &allocator, const CubeSource &source,
+	                       const vector<string> &dimension_names, const vector<string> &dimension_texts,
+	                       StatsRecorder stats) {
+		auto &decoded = stream.decoded;
+		ResponseDecoder decoder(allocator, decoded.cube, dimension_names, dimension_texts, std::move(stats));
+		try {
+			source([&](const char *data, idx_t size) {
+				{
+					lock_guard<mutex> guard(stream.lock);
+					decoder.Feed(data, size);
+					PublishCells(stream, decoded, decoder);
+				}
+				stream.changed.notify_all();
+				return !stream.cancellation->IsCancelled();
+			});
+			lock_guard<mutex> guard(stream.lock);
+			decoder.Finish();
+			PublishCells(stream, decoded, decoder);
+		} catch (...) {
+			lock_guard<mutex> guard(stream.lock);
+			stream.error = std::current_exception();
+		}
+		{
+			lock_guard<mutex> guard(stream.lock);
+			stream.finished = true;
 		}
+		stream.changed.notify_all();
+	}
 
-		yyjson_val *dim = yyjson_obj_get(dataset, "dimension");
-		if (!yyjson_is_obj(dim)) {
-			yyjson_doc_free(doc);
-			throw IOException("SISTAT_Read: dataset.dimension missing");
+	//! Wait on the stream until `done`. A download that no scheduler thread picked up after a short wait runs on this
+	//! thread instead: they may all be busy, possibly with scans that wait themselves.
+	static void AwaitStream(CubeStream &stream, unique_lock<mutex> &guard, const std::function<bool()> &done) {
+		if (!stream.changed.wait_for(guard, std::chrono::milliseconds(CLAIM_WAIT_MS), done) && !stream.claimed) {
+			guard.unlock();
+			stream.TryRun();
+			guard.lock();
 		}
+		stream.changed.wait(guard, done);
+	}
 
-		yyjson_val *id_arr = yyjson_obj_get(dim, "id");
-		if (!yyjson_is_arr(id_arr)) {
-			yyjson_doc_free(doc);
-			throw IOException("SISTAT_Read: dataset.dimension.id must be array");
+	//! Decode a cube in a scheduler task, so the scan can emit rows while the body is still arriving. `source` must
+	//! stop its requests when `cancellation` is cancelled. The owner of the stream calls Stop before releasing it.
+	static shared_ptr<CubeStream> StartStream(ClientContext &context, const BindData &bind_data, CubeSource source,
+	                                          StatsRecorder stats, shared_ptr<HttpCancellation> cancellation) {
+		auto result = make_shared_ptr<CubeStream>();
+		auto &stream = *result;
+		stream.cancellation = std::move(cancellation);
+		auto &allocator = BufferAllocator::Get(context);
+		auto dimension_names = bind_data.dimension_names;
+		auto dimension_texts = bind_data.dimension_texts;
+		stream.download = [&stream, &allocator, source, dimension_names, dimension_texts, stats]() {
+			StreamCube(stream, allocator, source, dimension_names, dimension_texts, stats);
+		};
+		auto &scheduler = TaskScheduler::GetScheduler(context);
+		stream.token = scheduler.CreateProducer();
+		scheduler.ScheduleTask(*stream.token, make_shared_ptr<StreamTask>(result));
+		return result;
+	}
+
+	//! Start the download of one request as a stream
+	static shared_ptr<CubeStream> StartDownload(ClientContext &context, const BindData &bind_data,
+	                                            const HttpSettings &settings, const string &body) {
+		auto cancellation = make_shared_ptr<HttpCancellation>();
+		auto stream_settings = settings;
+		stream_settings.cancellation = cancellation;
+		auto table_url = bind_data.table_url;
+		CubeSource download = [stream_settings, table_url, body](const HttpBodyReceiver &receiver) {
+			ReceiveCube(stream_settings, table_url, body, receiver);
+		};
+		return StartStream(context, bind_data, std::move(download), settings.stats, std::move(cancellation));
+	}
+
+	//! Scan `stream` once its cube has a layout
+	static void AdoptStream(State &state, shared_ptr<CubeStream> stream_p) {
+		state.stream = std::move(stream_p);
+		auto &stream = *state.stream;
+		unique_lock<mutex> guard(stream.lock);
+		AwaitStream(stream, guard, [&]() { return stream.started || stream.finished; });
+		if (stream.error) {
+			std::rethrow_exception(stream.error);
 		}
+	}
 
-		yyjson_val *size_arr = yyjson_obj_get(dim, "size");
-		if (!yyjson_is_arr(size_arr)) {
-			yyjson_doc_free(doc);
-			throw IOException("SISTAT_Read: dataset.dimension.size must be array");
+	//! Wait until the streamed cells before `end` are decoded; returns the status dictionary that covers them
+	static shared_ptr<Vector> WaitForCells(State &state, idx_t end) {
+		auto &stream = *state.stream;
+		unique_lock<mutex> guard(stream.lock);
+		AwaitStream(stream, guard, [&]() { return stream.cells_ready >= end || stream.finished; });
+		if (stream.error) {
+			std::rethrow_exception(stream.error);
 		}
+		stream.decoded.BuildStatusDictionary();
+		return stream.decoded.status_dictionary;
+	}
 
-		size_t num_dim = yyjson_arr_size(id_arr);
-		if (yyjson_arr_size(size_arr) != num_dim) {
-			yyjson_doc_free(doc);
-			throw IOException("SISTAT_Read: dimension id/size length mismatch");
+	//! Sub-requests of one scan and the cube they are stitched into
+	struct PartialFetch {
+		PartialFetch(Allocator &allocator_p, const HttpSettings &settings_p, const BindData &bind_data_p)
+		    : allocator(allocator_p), settings(settings_p), bind_data(bind_data_p) {
 		}
+		Allocator &allocator;
+		const HttpSettings &settings;
+		const BindData &bind_data;
+		vector<string> bodies;
+		atomic<idx_t> next_request {0};
+		mutex lock;
+		JsonStatCube cube;
+	};
 
-		vector<string> dim_ids;
-		vector<size_t> sizes;
-		for (size_t i = 0; i < num_dim; i++) {
-			yyjson_val *id_val = yyjson_arr_get(id_arr, i);
-			if (yyjson_is_str(id_val)) {
-				dim_ids.push_back(yyjson_get_str(id_val));
-			} else {
-				dim_ids.emplace_back("");
+	class FetchPartTask final : public BaseExecutorTask {
+	public:
+		FetchPartTask(TaskExecutor &executor, PartialFetch &fetch_p) : BaseExecutorTask(executor), fetch(fetch_p) {
+		}
+
+		void ExecuteTask() override {
+			for (idx_t i = fetch.next_request++; i < fetch.bodies.size() && !executor.HasError();
+			     i = fetch.next_request++) {
+				auto part = FetchCube(fetch.allocator, fetch.settings, fetch.bind_data.table_url, fetch.bodies[i],
+				                      fetch.bind_data.dimension_names, fetch.bind_data.dimension_texts);
+				lock_guard<mutex> guard(fetch.lock);
+				fetch.cube.Merge(part);
+			}
+		}
+
+	private:
+		PartialFetch &fetch;
+	};
+
+	//! Lay out the cube that sub-responses are merged into: the requested dimensions in metadata order
+	static void InitializeStitchedCube(Allocator &allocator, const BindData &bind_data, const vector<bool> &eliminated,
+	                                   JsonStatCube &cube) {
+		vector<string> dimension_ids;
+		vector<vector<string>> codes_per_dim;
+		for (idx_t d = 0; d < bind_data.dimension_names.size(); d++) {
+			if (eliminated[d]) {
+				continue;
+			}
+			auto &selection = bind_data.selections[d];
+			dimension_ids.push_back(bind_data.dimension_names[d]);
+			codes_per_dim.push_back(selection.filtered ? selection.codes : bind_data.dimension_codes[d]);
+		}
+		cube.Initialize(allocator, std::move(dimension_ids), std::move(codes_per_dim));
+	}
+
+	//! Run the sub-requests on the task scheduler, at most `max_concurrency` at a time
+	static JsonStatCube FetchCubeParts(ClientContext &context, const HttpSettings &settings, const BindData &bind_data,
+	                                   const vector<vector<DimensionSelection>> &requests,
+	                                   const vector<bool> &eliminated) {
+		PartialFetch fetch(BufferAllocator::Get(context), settings, bind_data);
+		for (auto &request : requests) {
+			fetch.bodies.push_back(BuildQueryJson(bind_data, request, eliminated));
+		}
+		InitializeStitchedCube(fetch.allocator, bind_data, eliminated, fetch.cube);
+
+		TaskExecutor executor(context);
+		idx_t num_tasks = MinValue<idx_t>(requests.size(), MaxValue<idx_t>(settings.max_concurrency, 1));
+		for (idx_t i = 0; i < num_tasks; i++) {
+			executor.ScheduleTask(make_uniq<FetchPartTask>(executor, fetch));
+		}
+		executor.WorkOnTasks();
+		return std::move(fetch.cube);
+	}
+
+	static idx_t MaxCellsPerRequest(ClientContext &context) {
+		Value setting;
+		if (context.TryGetCurrentSetting(sistat::MAX_CELLS_PER_REQUEST_SETTING, setting) && !setting.IsNull()) {
+			return MaxValue<idx_t>(UBigIntValue::Get(setting), 1);
+		}
+		return sistat::DEFAULT_MAX_CELLS_PER_REQUEST;
+	}
+
+	//! Whether binding a read without filters starts downloading the whole cube
+	static bool Prefetch(ClientContext &context) {
+		Value setting;
+		return !context.TryGetCurrentSetting(sistat::PREFETCH_SETTING, setting) || setting.IsNull() ||
+		       BooleanValue::Get(setting);
+	}
+
+	//! Start downloading the whole cube while the query is planned. Filters pushed down later, eliminated dimensions
+	//! or a changed format give the scan a different request, which then does not adopt this one. Reads that would
+	//! be split or served from the disk cache are left to the scan.
+	static void StartBoundDownload(ClientContext &context, BindData &bind_data) {
+		HttpSettings settings = HttpRequest::ExtractHttpSettings(context, bind_data.table_url);
+		if (settings.use_cache || bind_data.eliminate_unused) {
+			return;
+		}
+		vector<bool> eliminated(bind_data.dimension_names.size(), false);
+		vector<vector<DimensionSelection>> requests;
+		SplitRequest(bind_data, bind_data.selections, eliminated, MaxCellsPerRequest(context), requests);
+		if (requests.size() != 1) {
+			return;
+		}
+		auto body = BuildQueryJson(bind_data, requests[0], eliminated);
+		settings.stats.call = bind_data.stats;
+		auto stream = StartDownload(context, bind_data, settings, body);
+		bind_data.bound_download = make_shared_ptr<BoundDownload>(std::move(body), std::move(stream));
+	}
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto state = make_uniq_base<GlobalTableFunctionState, State>();
+		State *state_ptr = static_cast<State *>(state.get());
+		state_ptr->column_ids = input.column_ids;
+		idx_t num_columns = bind_data.dimension_names.size();
+		state_ptr->cube_dims.resize(num_columns);
+		state_ptr->decoded.BuildDictionaries();
+		if (bind_data.empty_selection) {
+			if (bind_data.bound_download) {
+				bind_data.bound_download->Cancel();
 			}
-			yyjson_val *sz_val = yyjson_arr_get(size_arr, i);
-			if (yyjson_is_uint(sz_val)) {
-				sizes.push_back(yyjson_get_uint(sz_val));
+			return std::move(state);
+		}
+
+		HttpSettings settings = HttpRequest::ExtractHttpSettings(context, bind_data.table_url);
+		settings.stats.call = state_ptr->stats;
+		auto &allocator = BufferAllocator::Get(context);
+		auto eliminated = EliminatedDimensions(bind_data, input.column_ids);
+		vector<vector<DimensionSelection>> requests;
+		SplitRequest(bind_data, bind_data.selections, eliminated, MaxCellsPerRequest(context), requests);
+		shared_ptr<CubeStream> bound_stream;
+		if (bind_data.bound_download && requests.size() == 1) {
+			bound_stream = bind_data.bound_download->TryAdopt(BuildQueryJson(bind_data, requests[0], eliminated));
+		}
+		if (bind_data.bound_download && !bound_stream) {
+			// This plan's request differs from the one binding started, and so will every later execution's
+			bind_data.bound_download->Cancel();
+		}
+		if (bound_stream) {
+			AdoptStream(*state_ptr, std::move(bound_stream));
+		} else if (requests.size() == 1) {
+			auto body = BuildQueryJson(bind_data, requests[0], eliminated);
+			if (!settings.use_cache) {
+				// PX is decoded as it arrives, so rows are emitted before the download completes, and a scan that
+				// stops early cancels it
+				AdoptStream(*state_ptr, StartDownload(context, bind_data, settings, body));
 			} else {
-				sizes.push_back(0);
-			}
-		}
-
-		vector<vector<string>> codes_per_dim(num_dim);
-		for (size_t d = 0; d < num_dim; d++) {
-			yyjson_val *dim_obj = yyjson_obj_get(dim, dim_ids[d].c_str());
-			if (!yyjson_is_obj(dim_obj)) {
-				yyjson_doc_free(doc);
-				throw IOException("SISTAT_Read: dimension.%s missing", dim_ids[d].c_str());
-			}
-			yyjson_val *cat = yyjson_obj_get(dim_obj, "category");
-			if (!yyjson_is_obj(cat)) {
-				yyjson_doc_free(doc);
-				throw IOException("SISTAT_Read: dimension.%s.category missing", dim_ids[d].c_str());
-			}
-			yyjson_val *index_obj = yyjson_obj_get(cat, "index");
-			if (!yyjson_is_obj(index_obj)) {
-				yyjson_doc_free(doc);
-				throw IOException("SISTAT_Read: dimension.%s.category.index missing", dim_ids[d].c_str());
-			}
-			vector<string> codes(sizes[d]);
-			size_t iter_idx, iter_max;
-			yyjson_val *key = nullptr;
-			yyjson_val *val = nullptr;
-			yyjson_obj_foreach(index_obj, iter_idx, iter_max, key, val) {
-				if (yyjson_is_str(key) && yyjson_is_uint(val)) {
-					size_t pos = yyjson_get_uint(val);
-					if (pos < codes.size()) {
-						codes[pos] = yyjson_get_str(key);
-					}
+				state_ptr->decoded.cube = FetchCube(allocator, settings, bind_data.table_url, body,
+				                                    bind_data.dimension_names, bind_data.dimension_texts);
+			}
+		} else {
+			state_ptr->decoded.cube = FetchCubeParts(context, settings, bind_data, requests, eliminated);
+		}
+		if (!state_ptr->stream) {
+			state_ptr->decoded.BuildDictionaries();
+		}
+		for (idx_t c = 0; c < num_columns; c++) {
+			state_ptr->cube_dims[c] = state_ptr->Decoded().cube.FindDimension(bind_data.dimension_names[c]);
+		}
+		return std::move(state);
+	}
+
+	static void WriteValues(const JsonStatCube &cube, idx_t start, idx_t count, const LogicalType &type,
+	                        Vector &vec) {
+		auto &validity = FlatVector::Validity(vec);
+		if (type.id() == LogicalTypeId::DECIMAL) {
+			auto data = FlatVector::GetData<int64_t>(vec);
+			auto factor = std::pow(10.0, DecimalType::GetScale(type));
+			auto limit = std::pow(10.0, DecimalType::GetWidth(type));
+			for (idx_t i = 0; i < count; i++) {
+				auto cell = start + i;
+				if (!cube.HasValue(cell)) {
+					validity.SetInvalid(i);
+					continue;
 				}
+				auto scaled = std::round(cube.values[cell] * factor);
+				if (std::fabs(scaled) >= limit) {
+					throw ConversionException("SISTAT_Read: value %f does not fit %s", cube.values[cell],
+					                          type.ToString());
+				}
+				data[i] = static_cast<int64_t>(scaled);
+			}
+			return;
+		}
+		auto data = FlatVector::GetData<double>(vec);
+		for (idx_t i = 0; i < count; i++) {
+			auto cell = start + i;
+			if (!cube.HasValue(cell)) {
+				validity.SetInvalid(i);
+				continue;
 			}
-			codes_per_dim[d] = std::move(codes);
+			data[i] = cube.values[cell];
 		}
+	}
 
-		yyjson_val *value_arr = yyjson_obj_get(dataset, "value");
-		if (!yyjson_is_arr(value_arr)) {
-			yyjson_doc_free(doc);
-			throw IOException("SISTAT_Read: dataset.value must be array");
+	static unique_ptr<LocalTableFunctionState> InitLocal(ExecutionContext &context, TableFunctionInitInput &input,
+	                                                     GlobalTableFunctionState *global_state) {
+		return make_uniq<LocalState>();
+	}
+
+	static bool NextMorsel(State &state, LocalState &local) {
+		idx_t morsel = state.next_morsel++;
+		idx_t start = morsel * MORSEL_SIZE;
+		if (start >= state.Decoded().cube.CellCount()) {
+			return false;
+		}
+		local.morsel = morsel;
+		local.position = start;
+		local.end = MinValue<idx_t>(start + MORSEL_SIZE, state.Decoded().cube.CellCount());
+		return true;
+	}
+
+	static OperatorPartitionData GetPartitionData(ClientContext &context, TableFunctionGetPartitionInput &input) {
+		if (input.partition_info.RequiresPartitionColumns()) {
+			throw InternalException("SISTAT_Read: partition columns are not supported");
+		}
+		return OperatorPartitionData(input.local_state->Cast<LocalState>().morsel);
+	}
+
+	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+
+		auto &state = input.global_state->Cast<State>();
+		auto &local = input.local_state->Cast<LocalState>();
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto &decoded = state.Decoded();
+		if (local.position >= local.end && !NextMorsel(state, local)) {
+			return;
+		}
+		idx_t num_dim = bind_data.dimension_names.size();
+		idx_t start = local.position;
+		idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, local.end - start);
+		shared_ptr<Vector> streamed_statuses;
+		if (state.stream) {
+			streamed_statuses = WaitForCells(state, start + count);
+		}
+
+		for (idx_t col = 0; col < state.column_ids.size(); col++) {
+			auto column_id = state.column_ids[col];
+			auto &vec = output.data[col];
+			if (column_id < num_dim && state.cube_dims[column_id].IsValid()) {
+				decoded.WriteDimension(state.cube_dims[column_id].GetIndex(), start, count, vec);
+			} else if (column_id == num_dim) {
+				WriteValues(decoded.cube, start, count, bind_data.value_type, vec);
+			} else if (column_id == num_dim + 1) {
+				decoded.WriteStatus(streamed_statuses ? *streamed_statuses : *decoded.status_dictionary, start, count,
+				                    vec);
+			} else {
+				vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+				ConstantVector::SetNull(vec, true);
+			}
+		}
+		local.position += count;
+		output.SetCardinality(count);
+	}
+
+	//! Codes a dimension column can take after filter pushdown
+	static const vector<string> &SelectedCodes(const BindData &bind_data, idx_t dim) {
+		auto &selection = bind_data.selections[dim];
+		return selection.filtered ? selection.codes : bind_data.dimension_codes[dim];
+	}
+
+	static unique_ptr<NodeStatistics> Cardinality(ClientContext &context, const FunctionData *bind_data_p) {
+		auto &bind_data = bind_data_p->Cast<BindData>();
+		if (bind_data.empty_selection) {
+			return make_uniq<NodeStatistics>(0, 0);
+		}
+		idx_t cells = 1;
+		for (idx_t d = 0; d < bind_data.dimension_names.size(); d++) {
+			cells *= SelectedCodes(bind_data, d).size();
+		}
+		if (bind_data.eliminate_unused) {
+			// Eliminated dimensions are aggregated away, so the full cube is only an upper bound
+			return make_uniq<NodeStatistics>(cells);
+		}
+		return make_uniq<NodeStatistics>(cells, cells);
+	}
+
+	static unique_ptr<BaseStatistics> Statistics(ClientContext &context, const FunctionData *bind_data_p,
+	                                             column_t column_index) {
+		auto &bind_data = bind_data_p->Cast<BindData>();
+		if (column_index >= bind_data.dimension_names.size()) {
+			return nullptr;
+		}
+		auto &codes = SelectedCodes(bind_data, column_index);
+		auto stats = StringStats::CreateEmpty(LogicalType::VARCHAR);
+		for (auto &code : codes) {
+			StringStats::Update(stats, string_t(code.c_str(), static_cast<uint32_t>(code.size())));
+		}
+		// Every cell carries a code of every dimension that is part of the response
+		stats.Set(StatsInfo::CANNOT_HAVE_NULL_VALUES);
+		stats.SetDistinctCount(codes.size());
+		return stats.ToUnique();
+	}
+
+	//! Request and decode counters of the call, shown by EXPLAIN ANALYZE: those of binding and of this execution
+	static InsertionOrderPreservingMap<string> DynamicToString(TableFunctionDynamicToStringInput &input) {
+		SistatStats stats;
+		stats.Add(*input.bind_data->Cast<BindData>().stats);
+		if (input.global_state) {
+			stats.Add(*input.global_state->Cast<State>().stats);
+		}
+		return stats.ToProfilerInfo();
+	}
+
+	static TableFunction GetFunction() {
+
+		TableFunction func("SISTAT_Read", {LogicalType::VARCHAR}, Execute, Bind, Init, InitLocal);
+		func.named_parameters["language"] = LogicalType::VARCHAR;
+		func.named_parameters["eliminate_unused"] = LogicalType::BOOLEAN;
+		func.named_parameters["format"] = LogicalType::VARCHAR;
+		func.bind_replace = BindReplace;
+		func.pushdown_complex_filter = PushdownComplexFilter;
+		func.projection_pushdown = true;
+		func.get_partition_data = GetPartitionData;
+		func.cardinality = Cardinality;
+		func.statistics = Statistics;
+		func.dynamic_to_string = DynamicToString;
+		return func;
+	}
+
+	static void Register(ExtensionLoader &loader) {
+		loader.RegisterFunction(GetFunction());
+	}
+};
+
+struct SISTAT_ReadMany_Impl {
+
+	using ReadBindData = SISTAT_Read_Impl::BindData;
+	using DecodedCube = SISTAT_Read_Impl::DecodedCube;
+
+	struct BindData final : TableFunctionData {
+		//! Per-table read state, in argument order
+		vector<unique_ptr<ReadBindData>> tables;
+		//! Union of the dimension names of all tables, in order of first appearance
+		vector<string> dimension_names;
+		idx_t max_cells_per_request = sistat::DEFAULT_MAX_CELLS_PER_REQUEST;
+		//! Requests and decoding while binding, over all tables
+		shared_ptr<SistatStats> stats = make_shared_ptr<SistatStats>();
+	};
+
+	//! Metadata of all tables, fetched concurrently at bind time
+	struct MetadataFetch {
+		MetadataCache::Lookup lookup;
+		vector<string> table_urls;
+		vector<string> metadata;
+		atomic<idx_t> next_table {0};
+	};
+
+	class MetadataTask final : public BaseExecutorTask {
+	public:
+		MetadataTask(TaskExecutor &executor, MetadataFetch &fetch_p) : BaseExecutorTask(executor), fetch(fetch_p) {
 		}
 
-		size_t total_cells = 1;
-		for (size_t s : sizes) {
-			total_cells *= s;
+		void ExecuteTask() override {
+			for (idx_t i = fetch.next_table++; i < fetch.table_urls.size() && !executor.HasError();
+			     i = fetch.next_table++) {
+				fetch.metadata[i] = fetch.lookup.Get(fetch.table_urls[i], "SISTAT_ReadMany");
+			}
 		}
 
-		vector<size_t> stride(num_dim);
-		stride[num_dim - 1] = 1;
-		for (size_t d = num_dim - 1; d > 0; d--) {
-			stride[d - 1] = stride[d] * sizes[d];
+	private:
+		MetadataFetch &fetch;
+	};
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+
+		if (input.inputs.empty() || input.inputs[0].IsNull()) {
+			throw InvalidInputException("SISTAT_ReadMany: a list of table ids is required.");
 		}
+		string lang = SISTAT_Read_Impl::GetLanguage(input.named_parameters);
+		auto format = SISTAT_Read_Impl::GetFormat(input.named_parameters, "SISTAT_ReadMany");
 
-		state_ptr->rows.reserve(total_cells);
+		vector<string> table_ids;
+		MetadataFetch fetch;
+		auto base_url = sistat::BaseUrl(context);
+		fetch.lookup = MetadataCache::CreateLookup(context, sistat::TableUrl(base_url, lang, ""));
+		auto stats = make_shared_ptr<SistatStats>();
+		fetch.lookup.settings.stats.call = stats;
+		for (auto &table_id : ListValue::GetChildren(input.inputs[0])) {
+			if (table_id.IsNull() || StringValue::Get(table_id).empty()) {
+				throw InvalidInputException("SISTAT_ReadMany: table ids cannot be NULL or empty.");
+			}
+			table_ids.push_back(sistat::NormalizeTableId(StringValue::Get(table_id)));
+			fetch.table_urls.push_back(sistat::TableUrl(base_url, lang, table_ids.back()));
+		}
+		if (table_ids.empty()) {
+			throw InvalidInputException("SISTAT_ReadMany: the list of table ids cannot be empty.");
+		}
+		fetch.metadata.resize(table_ids.size());
 
-		for (size_t flat_idx = 0; flat_idx < total_cells; flat_idx++) {
+		TaskExecutor executor(context);
+		idx_t num_tasks = MinValue<idx_t>(table_ids.size(), MaxValue<idx_t>(fetch.lookup.settings.max_concurrency, 1));
+		for (idx_t i = 0; i < num_tasks; i++) {
+			executor.ScheduleTask(make_uniq<MetadataTask>(executor, fetch));
+		}
+		executor.WorkOnTasks();
 
-			vector<string> dim_vals(num_dim);
-			size_t rem = flat_idx;
-			for (size_t d = 0; d < num_dim; d++) {
-				size_t i = rem / stride[d];
-				rem %= stride[d];
-				if (i < codes_per_dim[d].size()) {
-					dim_vals[d] = codes_per_dim[d][i];
+		auto result = make_uniq<BindData>();
+		result->max_cells_per_request = SISTAT_Read_Impl::MaxCellsPerRequest(context);
+		result->stats = std::move(stats);
+		for (idx_t i = 0; i < table_ids.size(); i++) {
+			auto table = SISTAT_Read_Impl::ParseMetadata(fetch.metadata[i], table_ids[i], fetch.table_urls[i], lang);
+			table->format = format;
+			for (auto &name : table->dimension_names) {
+				auto &union_names = result->dimension_names;
+				if (std::find(union_names.begin(), union_names.end(), name) == union_names.end()) {
+					union_names.push_back(name);
 				}
 			}
+			result->tables.push_back(std::move(table));
+		}
 
-			yyjson_val *val_ele = yyjson_arr_get(value_arr, flat_idx);
-			string value_str;
-			if (yyjson_is_num(val_ele)) {
-				double dbl = yyjson_get_num(val_ele);
-				value_str = to_string(dbl);
-			} else if (yyjson_is_str(val_ele)) {
-				value_str = yyjson_get_str(val_ele);
-			} else if (yyjson_is_null(val_ele)) {
-				value_str.clear();
+		names.emplace_back("table_id");
+		return_types.push_back(LogicalType::VARCHAR);
+		for (auto &name : result->dimension_names) {
+			names.emplace_back(name);
+			return_types.push_back(LogicalType::VARCHAR);
+		}
+		// Tables may declare different decimals, so values are unioned as DOUBLE
+		names.emplace_back("value");
+		return_types.push_back(LogicalType::DOUBLE);
+		names.emplace_back("status");
+		return_types.push_back(LogicalType::VARCHAR);
+		return std::move(result);
+	}
+
+	static JsonStatCube FetchTable(Allocator &allocator, const HttpSettings &settings, const ReadBindData &table,
+	                               idx_t max_cells) {
+		vector<bool> eliminated(table.dimension_names.size(), false);
+		vector<vector<SISTAT_Read_Impl::DimensionSelection>> requests;
+		SISTAT_Read_Impl::SplitRequest(table, table.selections, eliminated, max_cells, requests);
+		if (requests.size() == 1) {
+			return SISTAT_Read_Impl::FetchCube(allocator, settings, table.table_url,
+			                                   SISTAT_Read_Impl::BuildQueryJson(table, requests[0], eliminated),
+			                                   table.dimension_names, table.dimension_texts);
+		}
+		// Tables are already fetched concurrently, so the parts of one table are fetched one after another
+		JsonStatCube cube;
+		SISTAT_Read_Impl::InitializeStitchedCube(allocator, table, eliminated, cube);
+		for (auto &request : requests) {
+			cube.Merge(SISTAT_Read_Impl::FetchCube(allocator, settings, table.table_url,
+			                                       SISTAT_Read_Impl::BuildQueryJson(table, request, eliminated),
+			                                       table.dimension_names, table.dimension_texts));
+		}
+		return cube;
+	}
+
+	//! Table downloads of one scan, run by scheduler tasks and by the scan itself. Shared with the tasks, so one that
+	//! only starts after the scan ended finds nothing left to do.
+	struct Downloads {
+		Downloads(const BindData &bind_data_p, Allocator &allocator_p, HttpSettings settings_p)
+		    : bind_data(bind_data_p), allocator(allocator_p), settings(std::move(settings_p)),
+		      cubes(bind_data.tables.size()), ready(bind_data.tables.size(), false) {
+		}
+
+		const BindData &bind_data;
+		Allocator &allocator;
+		HttpSettings settings;
+		unique_ptr<ProducerToken> token;
+		mutex lock;
+		std::condition_variable ready_cv;
+		vector<unique_ptr<DecodedCube>> cubes;
+		vector<bool> ready;
+		std::exception_ptr error;
+		//! Next table nobody has taken yet, and the downloads in progress
+		idx_t next_table = 0;
+		idx_t running = 0;
+
+		//! Download the next table nobody has taken yet; false when none is left
+		bool DownloadNext() {
+			idx_t i;
+			{
+				lock_guard<mutex> guard(lock);
+				if (next_table >= cubes.size()) {
+					return false;
+				}
+				i = next_table++;
+				running++;
+			}
+			auto decoded = make_uniq<DecodedCube>();
+			std::exception_ptr fetch_error;
+			try {
+				decoded->cube = FetchTable(allocator, settings, *bind_data.tables[i], bind_data.max_cells_per_request);
+				decoded->BuildDictionaries();
+			} catch (...) {
+				fetch_error = std::current_exception();
 			}
+			lock_guard<mutex> guard(lock);
+			cubes[i] = std::move(decoded);
+			ready[i] = true;
+			running--;
+			if (fetch_error && !error) {
+				error = fetch_error;
+			}
+			ready_cv.notify_all();
+			return true;
+		}
 
-			if (IsStatisticalSymbol(value_str)) {
-				state_ptr->rows.push_back(DataRow {std::move(dim_vals), value_str});
-			} else {
-				state_ptr->rows.push_back(DataRow {std::move(dim_vals), std::move(value_str)});
+		//! Leave the remaining tables alone, cancel the downloads in progress and wait for them to return
+		void Stop() {
+			{
+				lock_guard<mutex> guard(lock);
+				next_table = cubes.size();
 			}
+			settings.cancellation->Cancel();
+			unique_lock<mutex> guard(lock);
+			ready_cv.wait(guard, [&]() { return running == 0; });
 		}
+	};
 
-		yyjson_doc_free(doc);
+	class DownloadTask final : public Task {
+	public:
+		explicit DownloadTask(shared_ptr<Downloads> downloads_p) : downloads(std::move(downloads_p)) {
+		}
+
+		TaskExecutionResult Execute(TaskExecutionMode mode) override {
+			while (downloads->DownloadNext()) {
+			}
+			return TaskExecutionResult::TASK_FINISHED;
+		}
+
+	private:
+		shared_ptr<Downloads> downloads;
+	};
+
+	//! The scan emits whichever table is downloaded first
+	struct State final : GlobalTableFunctionState {
+		~State() override {
+			// A LIMIT may end the scan while tables are still downloading; they are cancelled rather than awaited
+			downloads->Stop();
+		}
+
+		shared_ptr<Downloads> downloads;
+		vector<bool> consumed;
+		//! Requests and decoding of this execution
+		shared_ptr<SistatStats> stats = make_shared_ptr<SistatStats>();
+
+		//! Table being scanned, its cube dimension per output dimension column, and the next cell
+		optional_idx current;
+		vector<optional_idx> cube_dims;
+		idx_t position = 0;
+	};
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto state = make_uniq<State>();
+		idx_t num_tables = bind_data.tables.size();
+		state->consumed.resize(num_tables, false);
+
+		auto settings = HttpRequest::ExtractHttpSettings(context, bind_data.tables[0]->table_url);
+		settings.stats.call = state->stats;
+		settings.cancellation = make_shared_ptr<HttpCancellation>();
+		idx_t num_tasks = MinValue<idx_t>(num_tables, MaxValue<idx_t>(settings.max_concurrency, 1));
+		state->downloads = make_shared_ptr<Downloads>(bind_data, BufferAllocator::Get(context), std::move(settings));
+		auto &scheduler = TaskScheduler::GetScheduler(context);
+		auto &downloads = *state->downloads;
+		downloads.token = scheduler.CreateProducer();
+		for (idx_t i = 0; i < num_tasks; i++) {
+			scheduler.ScheduleTask(*downloads.token, make_shared_ptr<DownloadTask>(state->downloads));
+		}
 		return std::move(state);
 	}
 
+	//! Wait for the next downloaded table that was not scanned yet; false once every table was scanned
+	static bool NextTable(const BindData &bind_data, State &state) {
+		auto &downloads = *state.downloads;
+		unique_lock<mutex> guard(downloads.lock);
+		while (true) {
+			if (downloads.error) {
+				std::rethrow_exception(downloads.error);
+			}
+			bool pending = false;
+			for (idx_t i = 0; i < downloads.ready.size(); i++) {
+				if (state.consumed[i]) {
+					continue;
+				}
+				if (!downloads.ready[i]) {
+					pending = true;
+					continue;
+				}
+				state.consumed[i] = true;
+				state.current = i;
+				state.position = 0;
+				state.cube_dims.clear();
+				for (auto &name : bind_data.dimension_names) {
+					state.cube_dims.push_back(downloads.cubes[i]->cube.FindDimension(name));
+				}
+				return true;
+			}
+			if (!pending) {
+				return false;
+			}
+			auto claim_wait = std::chrono::milliseconds(SISTAT_Read_Impl::CLAIM_WAIT_MS);
+			if (downloads.next_table >= downloads.cubes.size()) {
+				downloads.ready_cv.wait(guard);
+			} else if (downloads.ready_cv.wait_for(guard, claim_wait) == std::cv_status::timeout) {
+				// Every scheduler thread may be busy, possibly with scans that wait themselves
+				guard.unlock();
+				downloads.DownloadNext();
+				guard.lock();
+			}
+		}
+	}
+
 	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
 
-		auto &state = input.global_state->Cast<State>();
 		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto &state = input.global_state->Cast<State>();
+		while (!state.current.IsValid() ||
+		       state.position >= state.downloads->cubes[state.current.GetIndex()]->cube.CellCount()) {
+			if (!NextTable(bind_data, state)) {
+				return;
+			}
+		}
+		idx_t table_idx = state.current.GetIndex();
+		auto &decoded = *state.downloads->cubes[table_idx];
 		idx_t num_dim = bind_data.dimension_names.size();
-		idx_t count = 0;
-		idx_t limit = MinValue<idx_t>(state.current_row + STANDARD_VECTOR_SIZE, state.rows.size());
+		idx_t start = state.position;
+		idx_t count = MinValue<idx_t>(STANDARD_VECTOR_SIZE, decoded.cube.CellCount() - start);
 
-		for (; state.current_row < limit; state.current_row++, count++) {
-			auto &row = state.rows[state.current_row];
-			for (idx_t d = 0; d < num_dim; d++) {
-				output.data[d].SetValue(count, row.dimension_values[d]);
+		output.data[0].Reference(Value(bind_data.tables[table_idx]->table_id));
+		for (idx_t d = 0; d < num_dim; d++) {
+			auto &vec = output.data[1 + d];
+			if (state.cube_dims[d].IsValid()) {
+				decoded.WriteDimension(state.cube_dims[d].GetIndex(), start, count, vec);
+			} else {
+				vec.SetVectorType(VectorType::CONSTANT_VECTOR);
+				ConstantVector::SetNull(vec, true);
 			}
-			output.data[num_dim].SetValue(count, row.value);
 		}
+		SISTAT_Read_Impl::WriteValues(decoded.cube, start, count, LogicalType::DOUBLE, output.data[1 + num_dim]);
+		decoded.WriteStatus(start, count, output.data[2 + num_dim]);
+		state.position += count;
 		output.SetCardinality(count);
 	}
 
+	static unique_ptr<NodeStatistics> Cardinality(ClientContext &context, const FunctionData *bind_data_p) {
+		auto &bind_data = bind_data_p->Cast<BindData>();
+		idx_t rows = 0;
+		for (auto &table : bind_data.tables) {
+			idx_t cells = 1;
+			for (auto &codes : table->dimension_codes) {
+				cells *= codes.size();
+			}
+			rows += cells;
+		}
+		return make_uniq<NodeStatistics>(rows, rows);
+	}
+
+	static InsertionOrderPreservingMap<string> DynamicToString(TableFunctionDynamicToStringInput &input) {
+		SistatStats stats;
+		stats.Add(*input.bind_data->Cast<BindData>().stats);
+		if (input.global_state) {
+			stats.Add(*input.global_state->Cast<State>().stats);
+		}
+		return stats.ToProfilerInfo();
+	}
+
 	static void Register(ExtensionLoader &loader) {
 
-		TableFunction func("SISTAT_Read", {LogicalType::VARCHAR}, Execute, Bind, Init);
+		TableFunction func("SISTAT_ReadMany", {LogicalType::LIST(LogicalType::VARCHAR)}, Execute, Bind, Init);
 		func.named_parameters["language"] = LogicalType::VARCHAR;
+		func.named_parameters["format"] = LogicalType::VARCHAR;
+		func.cardinality = Cardinality;
+		func.dynamic_to_string = DynamicToString;
+		loader.RegisterFunction(func);
+	}
+};
+
+//! Decodes a json-stat or PX file on disk, for example a saved PxWeb response, with the same decoder and scan as
+//! SISTAT_Read. Without the network in the way this is also what the decode benchmarks run on.
+struct SISTAT_ReadFile_Impl {
+
+	using BindData = SISTAT_Read_Impl::BindData;
+	using State = SISTAT_Read_Impl::State;
+	using BoundCube = SISTAT_Read_Impl::BoundCube;
+	using ResponseDecoder = SISTAT_Read_Impl::ResponseDecoder;
+
+	//! Bytes read from the file at a time
+	static constexpr idx_t READ_SIZE = 64 * 1024;
+
+	//! Hand the file to `receiver` in pieces, as a download would arrive, until it is read or the receiver stops.
+	//! The bytes read count as body bytes.
+	static void ReadFile(FileSystem &fs, const string &path, const StatsRecorder &stats,
+	                     const HttpBodyReceiver &receiver) {
+		auto handle = fs.OpenFile(path, FileFlags::FILE_FLAGS_READ);
+		auto buffer = make_unsafe_uniq_array<char>(READ_SIZE);
+		while (true) {
+			auto read = handle->Read(buffer.get(), READ_SIZE);
+			if (read <= 0) {
+				return;
+			}
+			stats.Add(&SistatStats::body_bytes, NumericCast<uint64_t>(read));
+			if (!receiver(buffer.get(), NumericCast<idx_t>(read))) {
+				return;
+			}
+		}
+	}
+
+	//! Recognize json-stat by its leading brace; false while the body read so far is all whitespace
+	static bool TrySniffJson(const string &head, bool &is_json) {
+		for (auto c : head) {
+			if (!StringUtil::CharacterIsSpace(c)) {
+				is_json = c == '{';
+				return true;
+			}
+		}
+		return false;
+	}
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+
+		if (input.inputs.empty() || input.inputs[0].IsNull()) {
+			throw InvalidInputException("SISTAT_ReadFile: path is required.");
+		}
+		string path = StringValue::Get(input.inputs[0]);
+		auto &fs = FileSystem::GetFileSystem(context);
+		auto &allocator = BufferAllocator::Get(context);
+		StatsRecorder stats {make_shared_ptr<SistatStats>(), DatabaseStats::Get(context)};
+
+		// Only the head of a PX file is needed for the schema. json-stat only has its dimensions once the whole
+		// document is parsed, so it is decoded here and handed to the first scan.
+		string head;
+		bool sniffed = false;
+		bool is_json = false;
+		bool has_layout = false;
+		vector<string> dimension_ids;
+		vector<vector<string>> codes_per_dim;
+		ReadFile(fs, path, stats, [&](const char *data, idx_t size) {
+			head.append(data, size);
+			sniffed = TrySniffJson(head, is_json);
+			if (!sniffed) {
+				return true;
+			}
+			has_layout = !is_json && PxFile::ReadLayout(head, {}, {}, dimension_ids, codes_per_dim);
+			return !is_json && !has_layout;
+		});
+
+		shared_ptr<BoundCube> bound_cube;
+		if (sniffed && is_json) {
+			bound_cube = make_shared_ptr<BoundCube>();
+			ResponseDecoder decoder(allocator, bound_cube->cube, {}, {}, stats);
+			ReadFile(fs, path, stats, [&](const char *data, idx_t size) {
+				decoder.Feed(data, size);
+				return true;
+			});
+			decoder.Finish();
+			dimension_ids = bound_cube->cube.dimension_ids;
+			codes_per_dim = bound_cube->cube.codes_per_dim;
+		} else if (!has_layout) {
+			throw IOException("SISTAT_ReadFile: %s is neither a json-stat nor a PX file", path);
+		}
+
+		// The path stands in for the table id and URL; nothing is requested from the server
+		vector<bool> eliminable(dimension_ids.size(), false);
+		auto result = make_uniq<BindData>(path, path, string(), dimension_ids, std::move(codes_per_dim),
+		                                  std::move(eliminable));
+		result->bound_cube = std::move(bound_cube);
+		result->stats = stats.call;
+
+		for (const auto &name : dimension_ids) {
+			names.emplace_back(name);
+			return_types.push_back(LogicalType::VARCHAR);
+		}
+		names.emplace_back("value");
+		return_types.push_back(result->value_type);
+		names.emplace_back("status");
+		return_types.push_back(LogicalType::VARCHAR);
+		return std::move(result);
+	}
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto state = make_uniq_base<GlobalTableFunctionState, State>();
+		State *state_ptr = static_cast<State *>(state.get());
+		state_ptr->column_ids = input.column_ids;
+		if (bind_data.bound_cube && bind_data.bound_cube->TryTake(state_ptr->decoded.cube)) {
+			state_ptr->decoded.BuildDictionaries();
+		} else {
+			// PX, or a json-stat file whose bind-time decode was already used by an earlier execution
+			auto &fs = FileSystem::GetFileSystem(context);
+			auto path = bind_data.table_url;
+			StatsRecorder stats {state_ptr->stats, DatabaseStats::Get(context)};
+			auto cancellation = make_shared_ptr<HttpCancellation>();
+			SISTAT_Read_Impl::CubeSource file = [&fs, path, stats](const HttpBodyReceiver &receiver) {
+				ReadFile(fs, path, stats, receiver);
+			};
+			auto stream = SISTAT_Read_Impl::StartStream(context, bind_data, std::move(file), std::move(stats),
+			                                            std::move(cancellation));
+			SISTAT_Read_Impl::AdoptStream(*state_ptr, std::move(stream));
+		}
+		state_ptr->cube_dims.resize(bind_data.dimension_names.size());
+		for (idx_t c = 0; c < bind_data.dimension_names.size(); c++) {
+			state_ptr->cube_dims[c] = state_ptr->Decoded().cube.FindDimension(bind_data.dimension_names[c]);
+		}
+		return std::move(state);
+	}
+
+	static void Register(ExtensionLoader &loader) {
+
+		TableFunction func("SISTAT_ReadFile", {LogicalType::VARCHAR}, SISTAT_Read_Impl::Execute, Bind, Init,
+		                   SISTAT_Read_Impl::InitLocal);
+		func.projection_pushdown = true;
+		func.get_partition_data = SISTAT_Read_Impl::GetPartitionData;
+		func.cardinality = SISTAT_Read_Impl::Cardinality;
+		func.statistics = SISTAT_Read_Impl::Statistics;
+		func.dynamic_to_string = SISTAT_Read_Impl::DynamicToString;
 		loader.RegisterFunction(func);
 	}
 };
@@ -322,6 +1815,57 @@ struct SISTAT_Read_Impl {
 
 void SistatDataFunctions::Register(ExtensionLoader &loader) {
 	SISTAT_Read_Impl::Register(loader);
+	SISTAT_ReadMany_Impl::Register(loader);
+	SISTAT_ReadFile_Impl::Register(loader);
+}
+
+TableFunction SistatDataFunctions::GetReadFunction() {
+	return SISTAT_Read_Impl::GetFunction();
+}
+
+bool SistatDataFunctions::TryBindMirror(ClientContext &context, const string &table_id, const string &lang,
+                                        const vector<string> &names, const vector<LogicalType> &types,
+                                        TableFunction &function, unique_ptr<FunctionData> &bind_data) {
+	auto path = SISTAT_Read_Impl::SnapshotPath(context, table_id, lang);
+	if (path.empty()) {
+		return false;
+	}
+	auto entry = Catalog::GetEntry<TableFunctionCatalogEntry>(context, SYSTEM_CATALOG, DEFAULT_SCHEMA, "read_parquet",
+	                                                          OnEntryNotFound::RETURN_NULL);
+	if (!entry) {
+		// read_parquet in a query autoloads the parquet extension; a catalog scan has to ask for it
+		ExtensionHelper::TryAutoLoadExtension(context, "parquet");
+		entry = Catalog::GetEntry<TableFunctionCatalogEntry>(context, SYSTEM_CATALOG, DEFAULT_SCHEMA, "read_parquet",
+		                                                     OnEntryNotFound::RETURN_NULL);
+		if (!entry) {
+			return false;
+		}
+	}
+	auto parquet_scan = entry->functions.GetFunctionByArguments(context, {LogicalType::VARCHAR});
+	vector<Value> inputs {Value(path)};
+	named_parameter_map_t named_parameters;
+	vector<LogicalType> input_table_types;
+	vector<string> input_table_names;
+	TableFunctionRef ref;
+	TableFunctionBindInput bind_input(inputs, named_parameters, input_table_types, input_table_names, nullptr, nullptr,
+	                                  parquet_scan, ref);
+	vector<LogicalType> snapshot_types;
+	vector<string> snapshot_names;
+	auto snapshot_data = parquet_scan.bind(context, bind_input, snapshot_types, snapshot_names);
+	// A snapshot of an older revision of the table is left alone; the catalog entry describes the current one
+	if (snapshot_names != names || snapshot_types != types) {
+		return false;
+	}
+	function = std::move(parquet_scan);
+	bind_data = std::move(snapshot_data);
+	return true;
+}
+
+unique_ptr<FunctionData> SistatDataFunctions::BindRead(const string &metadata, const string &table_id,
+                                                       const string &table_url, const string &lang,
+                                                       vector<LogicalType> &return_types, vector<string> &names) {
+	return SISTAT_Read_Impl::BindTable(metadata, table_id, table_url, lang, make_shared_ptr<SistatStats>(),
+	                                   return_types, names);
 }
 
 } // namespace duckdb
@@ -1,10 +1,24 @@
 #pragma once
 
+#include "duckdb/function/table_function.hpp"
+
 namespace duckdb {
 
 class ExtensionLoader;
 struct SistatDataFunctions {
 	static void Register(ExtensionLoader &loader);
+
+	//! SISTAT_Read, which also scans the tables of an attached SiStat catalog
+	static TableFunction GetReadFunction();
+	//! Bind SISTAT_Read to a table whose metadata is already known. Nothing is downloaded until the scan starts.
+	static unique_ptr<FunctionData> BindRead(const string &metadata, const string &table_id, const string &table_url,
+	                                         const string &lang, vector<LogicalType> &return_types,
+	                                         vector<string> &names);
+	//! Bind read_parquet on the sistat_mirror_directory snapshot of a table, as SISTAT_Read does through its
+	//! bind_replace. False when there is no snapshot, or its columns differ from `names` and `types`.
+	static bool TryBindMirror(ClientContext &context, const string &table_id, const string &lang,
+	                          const vector<string> &names, const vector<LogicalType> &types, TableFunction &function,
+	                          unique_ptr<FunctionData> &bind_data);
 };
 
 } // namespace duckdb
@@ -6,6 +6,8 @@
 #include "yyjson.hpp"
 #include "sistat.hpp"
 #include "http_request.hpp"
+#include "metadata_cache.hpp"
+#include "response_cache.hpp"
 
 using duckdb_yyjson::yyjson_arr_get;
 using duckdb_yyjson::yyjson_arr_size;
@@ -19,10 +21,6 @@ using duckdb_yyjson::yyjson_is_str;
 using duckdb_yyjson::yyjson_obj_get;
 using duckdb_yyjson::yyjson_read;
 using duckdb_yyjson::yyjson_val;
-using duckdb_yyjson::yyjson_val_write;
-using duckdb_yyjson::yyjson_val_write_file;
-using duckdb_yyjson::yyjson_val_write_opts;
-using duckdb_yyjson::YYJSON_WRITE_NOFLAG;
 
 namespace duckdb {
 
@@ -62,7 +60,7 @@ struct SISTAT_Tables_Impl {
 			lang = sistat::DEFAULT_LANGUAGE;
 		}
 
-		string list_url = string(sistat::BASE_URL) + lang + "/" + sistat::DATA_PATH;
+		string list_url = sistat::TableUrl(sistat::BaseUrl(context), lang, "");
 
 		names.emplace_back("title");
 		return_types.push_back(LogicalType::VARCHAR);
@@ -82,53 +80,14 @@ struct SISTAT_Tables_Impl {
 		auto state = make_uniq_base<GlobalTableFunctionState, State>();
 		State *state_ptr = static_cast<State *>(state.get());
 
-		HttpSettings settings = HttpRequest::ExtractHttpSettings(context, bind_data.list_url);
-		HttpResponseData resp = HttpRequest::ExecuteHttpRequest(settings, bind_data.list_url, "GET", {}, "", "");
-
-		if (!resp.error.empty()) {
-			throw IOException("SISTAT_Tables: %s", resp.error.c_str());
-		}
-		if (resp.status_code != 200) {
-			throw IOException("SISTAT_Tables: HTTP %d - %s", resp.status_code, resp.body.c_str());
-		}
-
-		yyjson_doc *doc = yyjson_read(resp.body.c_str(), resp.body.size(), 0);
-		if (!doc) {
-			throw IOException("SISTAT_Tables: Invalid JSON from list endpoint");
-		}
-
-		yyjson_val *root = yyjson_doc_get_root(doc);
-		if (!yyjson_is_arr(root)) {
-			yyjson_doc_free(doc);
-			throw IOException("SISTAT_Tables: Expected JSON array");
-		}
-
-		size_t n = yyjson_arr_size(root);
-		state_ptr->rows.reserve(n);
-
-		for (size_t i = 0; i < n; i++) {
-			yyjson_val *obj = yyjson_arr_get(root, i);
-			if (!yyjson_is_obj(obj)) {
-				continue;
-			}
+		for (auto &listing : SistatInfoFunctions::ListTables(context, bind_data.list_url, "SISTAT_Tables")) {
 			TableRow row;
-			yyjson_val *v = yyjson_obj_get(obj, "text");
-			if (yyjson_is_str(v)) {
-				row.title = yyjson_get_str(v);
-			}
-			v = yyjson_obj_get(obj, "id");
-			if (yyjson_is_str(v)) {
-				row.table_id = yyjson_get_str(v);
-			}
-			v = yyjson_obj_get(obj, "updated");
-			if (yyjson_is_str(v)) {
-				row.updated = yyjson_get_str(v);
-			}
+			row.title = std::move(listing.title);
+			row.table_id = std::move(listing.table_id);
+			row.updated = std::move(listing.updated);
 			row.url = bind_data.list_url + row.table_id;
 			state_ptr->rows.push_back(std::move(row));
 		}
-
-		yyjson_doc_free(doc);
 		return std::move(state);
 	}
 
@@ -172,24 +131,26 @@ struct SISTAT_DataStructure_Impl {
 		string variable_code;
 		string variable_text;
 		int64_t position;
-		string value_codes_json;
-		string value_texts_json;
+		vector<string> value_codes;
+		vector<string> value_texts;
 	};
 
 	struct State final : GlobalTableFunctionState {
 		vector<VariableRow> rows;
+		//! Next variable to emit, and for SISTAT_DataStructureValues the next value within it
 		idx_t current_row = 0;
+		idx_t current_value = 0;
 	};
 
-	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
-	                                     vector<LogicalType> &return_types, vector<string> &names) {
+	static unique_ptr<FunctionData> BindTable(ClientContext &context, TableFunctionBindInput &input,
+	                                          const string &function_name) {
 
 		if (input.inputs.empty()) {
-			throw InvalidInputException("SISTAT_DataStructure: table_id is required.");
+			throw InvalidInputException("%s: table_id is required.", function_name);
 		}
 		string table_id = StringValue::Get(input.inputs[0]);
 		if (table_id.empty()) {
-			throw InvalidInputException("SISTAT_DataStructure: table_id cannot be empty.");
+			throw InvalidInputException("%s: table_id cannot be empty.", function_name);
 		}
 
 		string lang = sistat::DEFAULT_LANGUAGE;
@@ -202,7 +163,12 @@ struct SISTAT_DataStructure_Impl {
 		}
 
 		string normalized_id = sistat::NormalizeTableId(table_id);
-		string table_url = sistat::TableUrl(lang, normalized_id);
+		string table_url = sistat::TableUrl(sistat::BaseUrl(context), lang, normalized_id);
+		return make_uniq_base<FunctionData, BindData>(normalized_id, table_url, lang);
+	}
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
 
 		names.emplace_back("table_id");
 		return_types.push_back(LogicalType::VARCHAR);
@@ -213,59 +179,73 @@ struct SISTAT_DataStructure_Impl {
 		names.emplace_back("position");
 		return_types.push_back(LogicalType::BIGINT);
 		names.emplace_back("value_codes");
-		return_types.push_back(LogicalType::VARCHAR);
+		return_types.push_back(LogicalType::LIST(LogicalType::VARCHAR));
 		names.emplace_back("value_texts");
+		return_types.push_back(LogicalType::LIST(LogicalType::VARCHAR));
+
+		return BindTable(context, input, "SISTAT_DataStructure");
+	}
+
+	static unique_ptr<FunctionData> BindValues(ClientContext &context, TableFunctionBindInput &input,
+	                                           vector<LogicalType> &return_types, vector<string> &names) {
+
+		names.emplace_back("table_id");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("variable_code");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("variable_text");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("variable_position");
+		return_types.push_back(LogicalType::BIGINT);
+		names.emplace_back("position");
+		return_types.push_back(LogicalType::BIGINT);
+		names.emplace_back("code");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("text");
 		return_types.push_back(LogicalType::VARCHAR);
 
-		return make_uniq_base<FunctionData, BindData>(normalized_id, table_url, lang);
+		return BindTable(context, input, "SISTAT_DataStructureValues");
 	}
 
-	static string JsonToString(yyjson_val *val) {
-		if (!val) {
-			return "[]";
+	static vector<string> StringArray(yyjson_val *arr) {
+		vector<string> result;
+		if (!yyjson_is_arr(arr)) {
+			return result;
 		}
-		const char *json = yyjson_val_write(val, YYJSON_WRITE_NOFLAG, nullptr);
-		if (!json) {
-			return "[]";
+		result.reserve(yyjson_arr_size(arr));
+		size_t arr_idx, arr_max;
+		yyjson_val *item = nullptr;
+		yyjson_arr_foreach(arr, arr_idx, arr_max, item) {
+			result.emplace_back(yyjson_is_str(item) ? yyjson_get_str(item) : "");
 		}
-		string s(json);
-		free((void *)json);
-		return s;
+		return result;
 	}
 
-	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+	static unique_ptr<GlobalTableFunctionState> InitTable(ClientContext &context, const BindData &bind_data,
+	                                                      const string &function_name) {
 
-		auto &bind_data = input.bind_data->Cast<BindData>();
 		auto state = make_uniq_base<GlobalTableFunctionState, State>();
 		State *state_ptr = static_cast<State *>(state.get());
 
-		HttpSettings settings = HttpRequest::ExtractHttpSettings(context, bind_data.table_url);
-		HttpResponseData resp = HttpRequest::ExecuteHttpRequest(settings, bind_data.table_url, "GET", {}, "", "");
-
-		if (!resp.error.empty()) {
-			throw IOException("SISTAT_DataStructure: %s", resp.error.c_str());
-		}
-		if (resp.status_code != 200) {
-			throw IOException("SISTAT_DataStructure: HTTP %d - %s", resp.status_code, resp.body.c_str());
-		}
-
-		yyjson_doc *doc = yyjson_read(resp.body.c_str(), resp.body.size(), 0);
+		string metadata = MetadataCache::GetTableMetadata(context, bind_data.table_url, function_name);
+		yyjson_doc *doc = yyjson_read(metadata.c_str(), metadata.size(), 0);
 		if (!doc) {
-			throw IOException("SISTAT_DataStructure: Invalid JSON");
+			throw IOException("%s: Invalid JSON", function_name);
 		}
 
 		yyjson_val *root = yyjson_doc_get_root(doc);
 		yyjson_val *variables = yyjson_is_obj(root) ? yyjson_obj_get(root, "variables") : nullptr;
 		if (!yyjson_is_arr(variables)) {
 			yyjson_doc_free(doc);
-			throw IOException("SISTAT_DataStructure: Expected object with 'variables' array");
+			throw IOException("%s: Expected object with 'variables' array", function_name);
 		}
 
 		size_t n = yyjson_arr_size(variables);
 		state_ptr->rows.reserve(n);
 
-		for (size_t pos = 0; pos < n; pos++) {
-			yyjson_val *var_obj = yyjson_arr_get(variables, pos);
+		size_t pos, pos_max;
+		yyjson_val *var_obj = nullptr;
+		yyjson_arr_foreach(variables, pos, pos_max, var_obj) {
 			if (!yyjson_is_obj(var_obj)) {
 				continue;
 			}
@@ -281,8 +261,8 @@ struct SISTAT_DataStructure_Impl {
 			if (yyjson_is_str(v)) {
 				row.variable_text = yyjson_get_str(v);
 			}
-			row.value_codes_json = JsonToString(yyjson_obj_get(var_obj, "values"));
-			row.value_texts_json = JsonToString(yyjson_obj_get(var_obj, "valueTexts"));
+			row.value_codes = StringArray(yyjson_obj_get(var_obj, "values"));
+			row.value_texts = StringArray(yyjson_obj_get(var_obj, "valueTexts"));
 			state_ptr->rows.push_back(std::move(row));
 		}
 
@@ -290,6 +270,27 @@ struct SISTAT_DataStructure_Impl {
 		return std::move(state);
 	}
 
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+		return InitTable(context, input.bind_data->Cast<BindData>(), "SISTAT_DataStructure");
+	}
+
+	static unique_ptr<GlobalTableFunctionState> InitValues(ClientContext &context, TableFunctionInitInput &input) {
+		return InitTable(context, input.bind_data->Cast<BindData>(), "SISTAT_DataStructureValues");
+	}
+
+	//! Append `values` as the list at `row` of a LIST(VARCHAR) vector
+	static void WriteList(Vector &vec, idx_t row, const vector<string> &values) {
+		auto offset = ListVector::GetListSize(vec);
+		ListVector::Reserve(vec, offset + values.size());
+		auto &child = ListVector::GetEntry(vec);
+		auto child_data = FlatVector::GetData<string_t>(child);
+		for (idx_t i = 0; i < values.size(); i++) {
+			child_data[offset + i] = StringVector::AddString(child, values[i]);
+		}
+		ListVector::GetData(vec)[row] = list_entry_t(offset, values.size());
+		ListVector::SetListSize(vec, offset + values.size());
+	}
+
 	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
 
 		auto &state = input.global_state->Cast<State>();
@@ -302,8 +303,32 @@ struct SISTAT_DataStructure_Impl {
 			output.data[1].SetValue(count, row.variable_code);
 			output.data[2].SetValue(count, row.variable_text);
 			output.data[3].SetValue(count, Value::BIGINT(row.position));
-			output.data[4].SetValue(count, row.value_codes_json);
-			output.data[5].SetValue(count, row.value_texts_json);
+			WriteList(output.data[4], count, row.value_codes);
+			WriteList(output.data[5], count, row.value_texts);
+		}
+		output.SetCardinality(count);
+	}
+
+	static void ExecuteValues(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+
+		auto &state = input.global_state->Cast<State>();
+		idx_t count = 0;
+		while (count < STANDARD_VECTOR_SIZE && state.current_row < state.rows.size()) {
+			auto &row = state.rows[state.current_row];
+			if (state.current_value >= row.value_codes.size()) {
+				state.current_row++;
+				state.current_value = 0;
+				continue;
+			}
+			auto i = state.current_value++;
+			output.data[0].SetValue(count, row.table_id);
+			output.data[1].SetValue(count, row.variable_code);
+			output.data[2].SetValue(count, row.variable_text);
+			output.data[3].SetValue(count, Value::BIGINT(row.position));
+			output.data[4].SetValue(count, Value::BIGINT(static_cast<int64_t>(i)));
+			output.data[5].SetValue(count, row.value_codes[i]);
+			output.data[6].SetValue(count, i < row.value_texts.size() ? Value(row.value_texts[i]) : Value());
+			count++;
 		}
 		output.SetCardinality(count);
 	}
@@ -313,14 +338,204 @@ struct SISTAT_DataStructure_Impl {
 		TableFunction func("SISTAT_DataStructure", {LogicalType::VARCHAR}, Execute, Bind, Init);
 		func.named_parameters["language"] = LogicalType::VARCHAR;
 		loader.RegisterFunction(func);
+
+		TableFunction values_func("SISTAT_DataStructureValues", {LogicalType::VARCHAR}, ExecuteValues, BindValues,
+		                          InitValues);
+		values_func.named_parameters["language"] = LogicalType::VARCHAR;
+		loader.RegisterFunction(values_func);
+	}
+};
+
+struct SISTAT_ClearCache_Impl {
+
+	struct State final : GlobalTableFunctionState {
+		bool done = false;
+	};
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+
+		names.emplace_back("metadata_entries");
+		return_types.push_back(LogicalType::BIGINT);
+		names.emplace_back("disk_entries");
+		return_types.push_back(LogicalType::BIGINT);
+		return make_uniq<TableFunctionData>();
+	}
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+		return make_uniq_base<GlobalTableFunctionState, State>();
+	}
+
+	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+
+		auto &state = input.global_state->Cast<State>();
+		if (state.done) {
+			return;
+		}
+		state.done = true;
+		string cache_directory;
+		Value setting;
+		if (context.TryGetCurrentSetting(sistat::CACHE_DIRECTORY_SETTING, setting) && !setting.IsNull()) {
+			cache_directory = setting.ToString();
+		}
+		output.data[0].SetValue(0, Value::BIGINT(static_cast<int64_t>(MetadataCache::Clear(context))));
+		output.data[1].SetValue(0, Value::BIGINT(static_cast<int64_t>(ResponseCache::Clear(cache_directory))));
+		output.SetCardinality(1);
+	}
+
+	static void Register(ExtensionLoader &loader) {
+
+		TableFunction func("SISTAT_ClearCache", {}, Execute, Bind, Init);
+		loader.RegisterFunction(func);
+	}
+};
+
+//! Database-wide totals of every SiStat call since the database was opened
+struct SISTAT_Stats_Impl {
+
+	struct State final : GlobalTableFunctionState {
+		bool done = false;
+	};
+
+	static Value Count(const atomic<uint64_t> &counter) {
+		return Value::BIGINT(static_cast<int64_t>(counter.load()));
+	}
+
+	static Value Millis(const atomic<uint64_t> &micros) {
+		return Value::DOUBLE(static_cast<double>(micros.load()) / 1000.0);
+	}
+
+	//! Share of `hits` among all lookups; NULL before the first lookup
+	static Value Ratio(const atomic<uint64_t> &hits, const atomic<uint64_t> &misses) {
+		auto total = hits.load() + misses.load();
+		if (total == 0) {
+			return Value(LogicalType::DOUBLE);
+		}
+		return Value::DOUBLE(static_cast<double>(hits.load()) / static_cast<double>(total));
+	}
+
+	//! Output columns and their values; Bind takes the names and types from an empty set of counters
+	static vector<std::pair<string, Value>> Row(const SistatStats &stats) {
+		return {
+		    {"requests", Count(stats.requests)},
+		    {"retries", Count(stats.retries)},
+		    {"connections_opened", Count(stats.connections_opened)},
+		    {"connections_reused", Count(stats.connections_reused)},
+		    {"connection_reuse_ratio", Ratio(stats.connections_reused, stats.connections_opened)},
+		    {"throttle_wait_ms", Millis(stats.throttle_wait_us)},
+		    {"dns_ms", Millis(stats.dns_us)},
+		    {"first_byte_ms", Millis(stats.first_byte_us)},
+		    {"transfer_ms", Millis(stats.transfer_us)},
+		    {"wire_bytes", Count(stats.wire_bytes)},
+		    {"body_bytes", Count(stats.body_bytes)},
+		    {"inflate_ms", Millis(stats.inflate_us)},
+		    {"parse_ms", Millis(stats.parse_us)},
+		    {"decode_ms", Millis(stats.decode_us)},
+		    {"cells_decoded", Count(stats.cells_decoded)},
+		    {"metadata_cache_hits", Count(stats.metadata_cache_hits)},
+		    {"metadata_cache_misses", Count(stats.metadata_cache_misses)},
+		    {"metadata_cache_hit_ratio", Ratio(stats.metadata_cache_hits, stats.metadata_cache_misses)},
+		    {"disk_cache_hits", Count(stats.disk_cache_hits)},
+		    {"disk_cache_misses", Count(stats.disk_cache_misses)},
+		    {"disk_cache_hit_ratio", Ratio(stats.disk_cache_hits, stats.disk_cache_misses)},
+		};
+	}
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+
+		SistatStats empty;
+		for (auto &column : Row(empty)) {
+			names.push_back(column.first);
+			return_types.push_back(column.second.type());
+		}
+		return make_uniq<TableFunctionData>();
+	}
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+		return make_uniq_base<GlobalTableFunctionState, State>();
+	}
+
+	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+
+		auto &state = input.global_state->Cast<State>();
+		if (state.done) {
+			return;
+		}
+		state.done = true;
+		auto row = Row(DatabaseStats::Get(context)->totals);
+		for (idx_t col = 0; col < row.size(); col++) {
+			output.data[col].SetValue(0, row[col].second);
+		}
+		output.SetCardinality(1);
+	}
+
+	static void Register(ExtensionLoader &loader) {
+
+		TableFunction func("SISTAT_Stats", {}, Execute, Bind, Init);
+		loader.RegisterFunction(func);
 	}
 };
 
 } // namespace
 
+vector<SistatInfoFunctions::TableListing>
+SistatInfoFunctions::ListTables(ClientContext &context, const string &list_url, const string &function_name) {
+	HttpSettings settings = HttpRequest::ExtractHttpSettings(context, list_url);
+	HttpResponseData resp = ResponseCache::ExecuteRequest(settings, list_url, "GET", {}, "", "");
+
+	if (!resp.error.empty()) {
+		throw IOException("%s: %s", function_name, resp.error);
+	}
+	if (resp.status_code != 200) {
+		throw IOException("%s: HTTP %d - %s", function_name, resp.status_code, resp.body);
+	}
+
+	yyjson_doc *doc = yyjson_read(resp.body.c_str(), resp.body.size(), 0);
+	if (!doc) {
+		throw IOException("%s: Invalid JSON from list endpoint", function_name);
+	}
+
+	yyjson_val *root = yyjson_doc_get_root(doc);
+	if (!yyjson_is_arr(root)) {
+		yyjson_doc_free(doc);
+		throw IOException("%s: Expected JSON array", function_name);
+	}
+
+	size_t n = yyjson_arr_size(root);
+	vector<TableListing> result;
+	result.reserve(n);
+
+	for (size_t i = 0; i < n; i++) {
+		yyjson_val *obj = yyjson_arr_get(root, i);
+		if (!yyjson_is_obj(obj)) {
+			continue;
+		}
+		TableListing listing;
+		yyjson_val *v = yyjson_obj_get(obj, "text");
+		if (yyjson_is_str(v)) {
+			listing.title = yyjson_get_str(v);
+		}
+		v = yyjson_obj_get(obj, "id");
+		if (yyjson_is_str(v)) {
+			listing.table_id = yyjson_get_str(v);
+		}
+		v = yyjson_obj_get(obj, "updated");
+		if (yyjson_is_str(v)) {
+			listing.updated = yyjson_get_str(v);
+		}
+		result.push_back(std::move(listing));
+	}
+
+	yyjson_doc_free(doc);
+	return result;
+}
+
 void SistatInfoFunctions::Register(ExtensionLoader &loader) {
 	SISTAT_Tables_Impl::Register(loader);
 	SISTAT_DataStructure_Impl::Register(loader);
+	SISTAT_ClearCache_Impl::Register(loader);
+	SISTAT_Stats_Impl::Register(loader);
 }
 
 } // namespace duckdb
@@ -1,10 +1,22 @@
 #pragma once
 
+#include "duckdb.hpp"
+
 namespace duckdb {
 
 class ExtensionLoader;
 struct SistatInfoFunctions {
 	static void Register(ExtensionLoader &loader);
+
+	//! One entry of a PxWeb table listing
+	struct TableListing {
+		string title;
+		string table_id;
+		string updated;
+	};
+	//! The tables listed at `list_url` (<base>/<lang>/Data/); errors are reported with `function_name` as prefix
+	static vector<TableListing> ListTables(ClientContext &context, const string &list_url,
+	                                       const string &function_name);
 };
 
 } // namespace duckdb
@@ -0,0 +1,61 @@
+#include "sistat_stats.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/main/client_context.hpp"
+
+namespace duckdb {
+
+static string FormatMillis(uint64_t micros) {
+	return StringUtil::Format("%.1f ms", static_cast<double>(micros) / 1000.0);
+}
+
+void SistatStats::Add(const SistatStats &other) {
+	static atomic<uint64_t> SistatStats::*const COUNTERS[] = {
+	    &SistatStats::requests, &SistatStats::retries, &SistatStats::connections_opened,
+	    &SistatStats::connections_reused, &SistatStats::throttle_wait_us, &SistatStats::dns_us,
+	    &SistatStats::first_byte_us, &SistatStats::transfer_us, &SistatStats::wire_bytes, &SistatStats::body_bytes,
+	    &SistatStats::inflate_us, &SistatStats::parse_us, &SistatStats::decode_us, &SistatStats::cells_decoded,
+	    &SistatStats::metadata_cache_hits, &SistatStats::metadata_cache_misses, &SistatStats::disk_cache_hits,
+	    &SistatStats::disk_cache_misses};
+	for (auto counter : COUNTERS) {
+		(this->*counter) += (other.*counter).load();
+	}
+}
+
+InsertionOrderPreservingMap<string> SistatStats::ToProfilerInfo() const {
+	InsertionOrderPreservingMap<string> result;
+	if (requests > 0) {
+		result["Requests"] = std::to_string(requests.load());
+		result["Retries"] = std::to_string(retries.load());
+		result["Connections"] = StringUtil::Format("%d opened, %d reused", connections_opened.load(),
+		                                           connections_reused.load());
+		result["Throttle Wait"] = FormatMillis(throttle_wait_us);
+		result["DNS"] = FormatMillis(dns_us);
+		result["First Byte"] = FormatMillis(first_byte_us);
+		result["Transfer"] = FormatMillis(transfer_us);
+		result["Wire Bytes"] = StringUtil::BytesToHumanReadableString(wire_bytes);
+		result["Body Bytes"] = StringUtil::BytesToHumanReadableString(body_bytes);
+		result["Inflate"] = FormatMillis(inflate_us);
+	}
+	if (parse_us > 0) {
+		result["JSON Parse"] = FormatMillis(parse_us);
+	}
+	if (cells_decoded > 0 || decode_us > 0) {
+		result["Decode"] = FormatMillis(decode_us);
+		result["Cells Decoded"] = std::to_string(cells_decoded.load());
+	}
+	if (metadata_cache_hits + metadata_cache_misses > 0) {
+		result["Metadata Cache"] = StringUtil::Format("%d hits, %d misses", metadata_cache_hits.load(),
+		                                              metadata_cache_misses.load());
+	}
+	if (disk_cache_hits + disk_cache_misses > 0) {
+		result["Disk Cache"] =
+		    StringUtil::Format("%d hits, %d misses", disk_cache_hits.load(), disk_cache_misses.load());
+	}
+	return result;
+}
+
+shared_ptr<DatabaseStats> DatabaseStats::Get(ClientContext &context) {
+	return ObjectCache::GetObjectCache(context).GetOrCreate<DatabaseStats>(ObjectType());
+}
+
+} // namespace duckdb
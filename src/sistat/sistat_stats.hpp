@@ -0,0 +1,94 @@
+#pragma once
+
+#include "duckdb.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/insertion_order_preserving_map.hpp"
+#include "duckdb/storage/object_cache.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+//! Counters of the work behind SiStat functions, split by phase so a slow read can be attributed. Each call keeps
+//! one set, shown in its EXPLAIN ANALYZE output, and every call also adds to the totals of its database, returned by
+//! SISTAT_Stats(). Times are in microseconds.
+struct SistatStats {
+	//! HTTP requests, and the attempts repeated after transport errors or 429/5xx answers
+	atomic<uint64_t> requests {0};
+	atomic<uint64_t> retries {0};
+	//! Attempts that had to open a connection, and attempts sent on a pooled keep-alive connection
+	atomic<uint64_t> connections_opened {0};
+	atomic<uint64_t> connections_reused {0};
+	//! Waiting for the request pacing and the concurrency window
+	atomic<uint64_t> throttle_wait_us {0};
+	//! Host name resolution on newly opened connections
+	atomic<uint64_t> dns_us {0};
+	//! From sending to the response headers: TCP and TLS handshakes on new connections, then server think time
+	atomic<uint64_t> first_byte_us {0};
+	//! Receiving the body, excluding the time spent decompressing and decoding it
+	atomic<uint64_t> transfer_us {0};
+	//! Body bytes as received, and after gzip/deflate decompression (for SISTAT_ReadFile, the bytes read from the file)
+	atomic<uint64_t> wire_bytes {0};
+	atomic<uint64_t> body_bytes {0};
+	atomic<uint64_t> inflate_us {0};
+	//! yyjson parsing of json-stat documents
+	atomic<uint64_t> parse_us {0};
+	//! Extracting cells: walking parsed json-stat, or decoding PX
+	atomic<uint64_t> decode_us {0};
+	atomic<uint64_t> cells_decoded {0};
+	atomic<uint64_t> metadata_cache_hits {0};
+	atomic<uint64_t> metadata_cache_misses {0};
+	//! Responses served from sistat_cache_directory (fresh, revalidated with a 304, or stale while the server fails)
+	//! and responses downloaded with the cache enabled
+	atomic<uint64_t> disk_cache_hits {0};
+	atomic<uint64_t> disk_cache_misses {0};
+
+	//! Add every counter of `other` to this one
+	void Add(const SistatStats &other);
+	//! The non-zero counters, for the extra info of a profiled table scan
+	InsertionOrderPreservingMap<string> ToProfilerInfo() const;
+};
+
+//! The totals of one database, kept in its object cache
+class DatabaseStats : public ObjectCacheEntry {
+public:
+	static string ObjectType() {
+		return "sistat_stats";
+	}
+	string GetObjectType() override {
+		return ObjectType();
+	}
+	optional_idx GetEstimatedCacheMemory() const override {
+		return sizeof(DatabaseStats);
+	}
+
+	static shared_ptr<DatabaseStats> Get(ClientContext &context);
+
+	SistatStats totals;
+};
+
+//! Where a call's counters go: its own stats when it keeps them, and the database totals. Copied into HttpSettings,
+//! so worker threads record without a ClientContext.
+struct StatsRecorder {
+	shared_ptr<SistatStats> call;
+	shared_ptr<DatabaseStats> database;
+
+	void Add(atomic<uint64_t> SistatStats::*counter, uint64_t amount) const {
+		if (amount == 0) {
+			return;
+		}
+		if (call) {
+			((*call).*counter) += amount;
+		}
+		if (database) {
+			((database->totals).*counter) += amount;
+		}
+	}
+
+	static uint64_t MicrosSince(std::chrono::steady_clock::time_point start) {
+		auto elapsed = std::chrono::steady_clock::now() - start;
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+	}
+};
+
+} // namespace duckdb
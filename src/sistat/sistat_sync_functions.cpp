@@ -0,0 +1,565 @@
+#include "sistat_sync_functions.hpp"
+#include "duckdb/main/client_context.hpp"
+#include "duckdb/main/connection.hpp"
+#include "duckdb/main/database.hpp"
+#include "duckdb/main/extension/extension_loader.hpp"
+#include "duckdb/function/table_function.hpp"
+#include "duckdb/parallel/task_executor.hpp"
+#include "duckdb/common/atomic.hpp"
+#include "duckdb/common/case_insensitive_map.hpp"
+#include "duckdb/common/file_system.hpp"
+#include "duckdb/common/random_engine.hpp"
+#include "duckdb/common/string_util.hpp"
+#include "duckdb/common/unordered_map.hpp"
+#include "duckdb/parser/keyword_helper.hpp"
+#include "sistat.hpp"
+#include "metadata_cache.hpp"
+#include "mirror.hpp"
+#include "response_cache.hpp"
+
+#include <chrono>
+
+namespace duckdb {
+
+namespace {
+
+struct SISTAT_Sync_Impl {
+
+	static constexpr idx_t DEFAULT_CONCURRENCY = 4;
+	static constexpr const char *LOG_TABLE = "sistat_sync_log";
+
+	struct BindData final : TableFunctionData {
+		//! Tables to synchronize; every table in the bookkeeping table when `tracked_only` is set
+		vector<string> table_ids;
+		bool tracked_only = false;
+		string language = sistat::DEFAULT_LANGUAGE;
+		string schema = DEFAULT_SCHEMA;
+		string prefix = "sistat_";
+		bool force = false;
+		idx_t concurrency = DEFAULT_CONCURRENCY;
+	};
+
+	struct SyncRow {
+		string table_id;
+		string target_table;
+		string status;
+		string updated;
+		int64_t rows = 0;
+		double elapsed_ms = 0;
+		string error;
+	};
+
+	struct State final : GlobalTableFunctionState {
+		vector<SyncRow> rows;
+		idx_t current_row = 0;
+	};
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+
+		auto result = make_uniq<BindData>();
+		if (input.inputs.empty()) {
+			result->tracked_only = true;
+		} else if (!input.inputs[0].IsNull()) {
+			for (auto &table_id : ListValue::GetChildren(input.inputs[0])) {
+				if (table_id.IsNull() || StringValue::Get(table_id).empty()) {
+					throw InvalidInputException("SISTAT_Sync: table ids cannot be NULL or empty.");
+				}
+				result->table_ids.push_back(sistat::NormalizeTableId(StringValue::Get(table_id)));
+			}
+		}
+
+		for (auto &kv : input.named_parameters) {
+			if (kv.second.IsNull()) {
+				continue;
+			}
+			if (kv.first == "language" && !StringValue::Get(kv.second).empty()) {
+				result->language = StringValue::Get(kv.second);
+			} else if (kv.first == "schema") {
+				result->schema = StringValue::Get(kv.second);
+			} else if (kv.first == "prefix") {
+				result->prefix = StringValue::Get(kv.second);
+			} else if (kv.first == "force") {
+				result->force = BooleanValue::Get(kv.second);
+			} else if (kv.first == "concurrency") {
+				result->concurrency =
+				    MaxValue<idx_t>(UBigIntValue::Get(kv.second.DefaultCastAs(LogicalType::UBIGINT)), 1);
+			}
+		}
+
+		names.emplace_back("table_id");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("target_table");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("status");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("updated");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("row_count");
+		return_types.push_back(LogicalType::BIGINT);
+		names.emplace_back("elapsed_ms");
+		return_types.push_back(LogicalType::DOUBLE);
+		names.emplace_back("error");
+		return_types.push_back(LogicalType::VARCHAR);
+
+		return std::move(result);
+	}
+
+	static unique_ptr<QueryResult> Run(Connection &con, const string &sql) {
+		auto result = con.Query(sql);
+		if (result->HasError()) {
+			result->ThrowError();
+		}
+		return std::move(result);
+	}
+
+	static string Literal(const string &value) {
+		return KeywordHelper::WriteQuoted(value, '\'');
+	}
+
+	//! Session settings of the caller, which a new connection would not see, with `overrides` applied on top
+	static case_insensitive_map_t<Value> SessionSettings(ClientContext &context,
+	                                                    const case_insensitive_map_t<Value> &overrides) {
+		auto settings = context.config.set_variables;
+		for (auto &kv : overrides) {
+			settings[kv.first] = kv.second;
+		}
+		return settings;
+	}
+
+	//! A connection for a worker thread that behaves like the caller's own
+	static unique_ptr<Connection> Connect(DatabaseInstance &db, const case_insensitive_map_t<Value> &settings) {
+		auto con = make_uniq<Connection>(db);
+		con->context->config.set_variables = settings;
+		return con;
+	}
+
+	//! Local table name for a table id, e.g. 05C1002S.px -> sistat_05c1002s
+	static string TargetTable(const BindData &bind_data, const string &table_id) {
+		auto name = table_id.substr(0, table_id.size() - 3);
+		return bind_data.prefix + StringUtil::Lower(name);
+	}
+
+	//! Tables to copy and the state the copies are compared against, shared by the sync tasks
+	struct SyncRun {
+		SyncRun(DatabaseInstance &db_p, const BindData &bind_data_p, vector<SyncRow> &rows_p)
+		    : db(db_p), bind_data(bind_data_p), rows(rows_p) {
+		}
+		DatabaseInstance &db;
+		const BindData &bind_data;
+		vector<SyncRow> &rows;
+		string log_table;
+		case_insensitive_map_t<Value> settings;
+		//! Updated timestamps listed by the server, and those of the copies made before
+		unordered_map<string, string> catalog;
+		unordered_map<string, string> known;
+		atomic<idx_t> next_table {0};
+	};
+
+	static void SyncTable(SyncRun &run, SyncRow &row) {
+		auto &bind_data = run.bind_data;
+		auto &catalog = run.catalog;
+		auto &known = run.known;
+		auto start = std::chrono::steady_clock::now();
+		auto catalog_entry = catalog.find(row.table_id);
+		if (catalog_entry == catalog.end()) {
+			row.status = "not_found";
+		} else {
+			row.updated = catalog_entry->second;
+			auto known_entry = known.find(row.table_id);
+			if (!bind_data.force && known_entry != known.end() && known_entry->second == row.updated) {
+				row.status = "unchanged";
+			} else {
+				auto con_ptr = Connect(run.db, run.settings);
+				auto &con = *con_ptr;
+				try {
+					auto target = KeywordHelper::WriteOptionallyQuoted(bind_data.schema) + "." +
+					              KeywordHelper::WriteOptionallyQuoted(row.target_table);
+					// One transaction per table: readers see either the old copy or the new one, never a mix
+					con.BeginTransaction();
+					auto created = Run(con, StringUtil::Format("CREATE OR REPLACE TABLE %s AS SELECT * FROM "
+					                                           "SISTAT_Read(%s, language := %s)",
+					                                           target, Literal(row.table_id),
+					                                           Literal(bind_data.language)));
+					auto count = created->Cast<MaterializedQueryResult>().GetValue(0, 0);
+					row.rows = count.IsNull() ? 0 : count.GetValue<int64_t>();
+					Run(con, StringUtil::Format("INSERT OR REPLACE INTO %s VALUES (%s, %s, %s, %s, "
+					                            "now()::TIMESTAMP, %d)",
+					                            run.log_table, Literal(row.table_id), Literal(bind_data.language),
+					                            Literal(row.target_table), Literal(row.updated), row.rows));
+					con.Commit();
+					row.status = "updated";
+				} catch (std::exception &ex) {
+					if (con.HasActiveTransaction()) {
+						con.Rollback();
+					}
+					ErrorData error(ex);
+					row.status = "failed";
+					row.rows = 0;
+					row.error = error.RawMessage();
+				}
+			}
+		}
+		row.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	class SyncTask final : public BaseExecutorTask {
+	public:
+		SyncTask(TaskExecutor &executor, SyncRun &run_p) : BaseExecutorTask(executor), run(run_p) {
+		}
+
+		void ExecuteTask() override {
+			// Failures are reported per table, so one table never stops the others
+			for (idx_t i = run.next_table++; i < run.rows.size(); i = run.next_table++) {
+				SyncTable(run, run.rows[i]);
+			}
+		}
+
+	private:
+		SyncRun &run;
+	};
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto state = make_uniq_base<GlobalTableFunctionState, State>();
+		State *state_ptr = static_cast<State *>(state.get());
+		// Copies are committed on their own connections, which a surrounding transaction could not roll back
+		if (!context.transaction.IsAutoCommit()) {
+			throw InvalidInputException("SISTAT_Sync: cannot run inside an explicit transaction; every table is "
+			                            "committed on its own as soon as it is copied.");
+		}
+
+		auto &db = DatabaseInstance::GetDatabase(context);
+		SyncRun run(db, bind_data, state_ptr->rows);
+		// Sync always downloads: a cached or mirrored body could be older than the updated timestamp it is stored with
+		run.settings = SessionSettings(context, {{sistat::METADATA_CACHE_SETTING, Value::BOOLEAN(false)},
+		                                         {sistat::CACHE_DIRECTORY_SETTING, Value("")},
+		                                         {sistat::MIRROR_DIRECTORY_SETTING, Value("")}});
+		auto con_ptr = Connect(db, run.settings);
+		auto &con = *con_ptr;
+		auto &log_table = run.log_table;
+		log_table = KeywordHelper::WriteOptionallyQuoted(bind_data.schema) + "." + LOG_TABLE;
+		Run(con, StringUtil::Format("CREATE TABLE IF NOT EXISTS %s (table_id VARCHAR, language VARCHAR, "
+		                            "target_table VARCHAR, updated VARCHAR, synced_at TIMESTAMP, row_count BIGINT, "
+		                            "PRIMARY KEY (table_id, language))",
+		                            log_table));
+
+		auto &known = run.known;
+		// In list order, without repeats: ids that differ only in case or the .px suffix name the same copy and log
+		// row, which two tasks would otherwise replace at once
+		vector<string> table_ids;
+		case_insensitive_set_t seen;
+		auto add_table = [&](const string &table_id) {
+			if (seen.insert(table_id).second) {
+				table_ids.push_back(table_id);
+			}
+		};
+		for (auto &table_id : bind_data.table_ids) {
+			add_table(table_id);
+		}
+		auto tracked = Run(con, StringUtil::Format("SELECT table_id, updated FROM %s WHERE language = %s ORDER BY 1",
+		                                           log_table, Literal(bind_data.language)));
+		for (auto &tracked_row : tracked->Cast<MaterializedQueryResult>().Collection().Rows()) {
+			auto table_id = tracked_row.GetValue(0).ToString();
+			known[table_id] = tracked_row.GetValue(1).IsNull() ? string() : tracked_row.GetValue(1).ToString();
+			if (bind_data.tracked_only) {
+				add_table(table_id);
+			}
+		}
+
+		auto &catalog = run.catalog;
+		auto listing = Run(con, StringUtil::Format("SELECT table_id, updated FROM SISTAT_Tables(language := %s)",
+		                                           Literal(bind_data.language)));
+		for (auto &listing_row : listing->Cast<MaterializedQueryResult>().Collection().Rows()) {
+			auto table_id = listing_row.GetValue(0).ToString();
+			if (!table_id.empty()) {
+				catalog[sistat::NormalizeTableId(table_id)] = listing_row.GetValue(1).ToString();
+			}
+		}
+
+		auto &rows = state_ptr->rows;
+		rows.resize(table_ids.size());
+		for (idx_t i = 0; i < table_ids.size(); i++) {
+			rows[i].table_id = table_ids[i];
+			rows[i].target_table = TargetTable(bind_data, table_ids[i]);
+		}
+
+		// Each task copies one table at a time on its own connection
+		TaskExecutor executor(context);
+		idx_t num_tasks = MinValue<idx_t>(bind_data.concurrency, rows.size());
+		for (idx_t i = 0; i < num_tasks; i++) {
+			executor.ScheduleTask(make_uniq<SyncTask>(executor, run));
+		}
+		executor.WorkOnTasks();
+		return std::move(state);
+	}
+
+	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+
+		auto &state = input.global_state->Cast<State>();
+		idx_t count = 0;
+		idx_t limit = MinValue<idx_t>(state.current_row + STANDARD_VECTOR_SIZE, state.rows.size());
+
+		for (; state.current_row < limit; state.current_row++, count++) {
+			auto &row = state.rows[state.current_row];
+			output.data[0].SetValue(count, row.table_id);
+			output.data[1].SetValue(count, row.target_table);
+			output.data[2].SetValue(count, row.status);
+			output.data[3].SetValue(count, row.updated.empty() ? Value() : Value(row.updated));
+			output.data[4].SetValue(count, Value::BIGINT(row.rows));
+			output.data[5].SetValue(count, Value::DOUBLE(row.elapsed_ms));
+			output.data[6].SetValue(count, row.error.empty() ? Value() : Value(row.error));
+		}
+		output.SetCardinality(count);
+	}
+
+	static TableFunction GetFunction(vector<LogicalType> arguments) {
+		TableFunction func("SISTAT_Sync", std::move(arguments), Execute, Bind, Init);
+		func.named_parameters["language"] = LogicalType::VARCHAR;
+		func.named_parameters["schema"] = LogicalType::VARCHAR;
+		func.named_parameters["prefix"] = LogicalType::VARCHAR;
+		func.named_parameters["force"] = LogicalType::BOOLEAN;
+		func.named_parameters["concurrency"] = LogicalType::UBIGINT;
+		return func;
+	}
+
+	static void Register(ExtensionLoader &loader) {
+
+		TableFunctionSet set("SISTAT_Sync");
+		set.AddFunction(GetFunction({}));
+		set.AddFunction(GetFunction({LogicalType::LIST(LogicalType::VARCHAR)}));
+		loader.RegisterFunction(set);
+	}
+};
+
+//! Downloads tables into local snapshots (see SistatMirror) that SISTAT_Read scans once sistat_mirror_directory
+//! points at them. Every call replaces the snapshots of the given tables.
+struct SISTAT_Mirror_Impl {
+
+	static constexpr idx_t DEFAULT_CONCURRENCY = 4;
+
+	struct BindData final : TableFunctionData {
+		vector<string> table_ids;
+		string language = sistat::DEFAULT_LANGUAGE;
+		string directory;
+		string base_url;
+		idx_t concurrency = DEFAULT_CONCURRENCY;
+	};
+
+	struct MirrorRow {
+		string table_id;
+		string path;
+		string status;
+		int64_t rows = 0;
+		int64_t file_size = 0;
+		double elapsed_ms = 0;
+		string error;
+	};
+
+	struct State final : GlobalTableFunctionState {
+		vector<MirrorRow> rows;
+		idx_t current_row = 0;
+	};
+
+	static unique_ptr<FunctionData> Bind(ClientContext &context, TableFunctionBindInput &input,
+	                                     vector<LogicalType> &return_types, vector<string> &names) {
+
+		auto result = make_uniq<BindData>();
+		if (input.inputs.empty() || input.inputs[0].IsNull()) {
+			throw InvalidInputException("SISTAT_Mirror: a list of table ids is required.");
+		}
+		// A table listed twice would be written by two tasks at once
+		case_insensitive_set_t seen;
+		for (auto &table_id : ListValue::GetChildren(input.inputs[0])) {
+			if (table_id.IsNull() || StringValue::Get(table_id).empty()) {
+				throw InvalidInputException("SISTAT_Mirror: table ids cannot be NULL or empty.");
+			}
+			auto normalized = sistat::NormalizeTableId(StringValue::Get(table_id));
+			if (seen.insert(normalized).second) {
+				result->table_ids.push_back(normalized);
+			}
+		}
+		result->directory = SistatMirror::Directory(context);
+		for (auto &kv : input.named_parameters) {
+			if (kv.second.IsNull()) {
+				continue;
+			}
+			if (kv.first == "language" && !StringValue::Get(kv.second).empty()) {
+				result->language = StringValue::Get(kv.second);
+			} else if (kv.first == "directory") {
+				result->directory = StringValue::Get(kv.second);
+			} else if (kv.first == "concurrency") {
+				result->concurrency =
+				    MaxValue<idx_t>(UBigIntValue::Get(kv.second.DefaultCastAs(LogicalType::UBIGINT)), 1);
+			}
+		}
+		if (result->directory.empty()) {
+			throw InvalidInputException("SISTAT_Mirror: set sistat_mirror_directory or pass directory := '...'.");
+		}
+		result->base_url = sistat::BaseUrl(context);
+
+		names.emplace_back("table_id");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("path");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("status");
+		return_types.push_back(LogicalType::VARCHAR);
+		names.emplace_back("row_count");
+		return_types.push_back(LogicalType::BIGINT);
+		names.emplace_back("file_size");
+		return_types.push_back(LogicalType::BIGINT);
+		names.emplace_back("elapsed_ms");
+		return_types.push_back(LogicalType::DOUBLE);
+		names.emplace_back("error");
+		return_types.push_back(LogicalType::VARCHAR);
+
+		return std::move(result);
+	}
+
+	//! Tables to snapshot, shared by the mirror tasks
+	struct MirrorRun {
+		MirrorRun(DatabaseInstance &db_p, FileSystem &fs_p, const BindData &bind_data_p,
+		          const MetadataCache::Lookup &lookup_p, vector<MirrorRow> &rows_p)
+		    : db(db_p), fs(fs_p), bind_data(bind_data_p), lookup(lookup_p), rows(rows_p) {
+		}
+		DatabaseInstance &db;
+		FileSystem &fs;
+		const BindData &bind_data;
+		const MetadataCache::Lookup &lookup;
+		vector<MirrorRow> &rows;
+		case_insensitive_map_t<Value> settings;
+		atomic<idx_t> next_table {0};
+	};
+
+	static void MirrorTable(MirrorRun &run, MirrorRow &row) {
+		auto &fs = run.fs;
+		auto &bind_data = run.bind_data;
+		auto start = std::chrono::steady_clock::now();
+		RandomEngine random;
+		auto temp_path = StringUtil::Format("%s.%08x.tmp", row.path, random.NextRandomInteger());
+		try {
+			auto table_url = sistat::TableUrl(bind_data.base_url, bind_data.language, row.table_id);
+			auto metadata = run.lookup.Get(table_url, "SISTAT_Mirror");
+
+			auto con_ptr = SISTAT_Sync_Impl::Connect(run.db, run.settings);
+			auto copied = SISTAT_Sync_Impl::Run(
+			    *con_ptr, StringUtil::Format("COPY (SELECT * FROM SISTAT_Read(%s, language := %s)) TO %s "
+			                                 "(FORMAT parquet)",
+			                                 SISTAT_Sync_Impl::Literal(row.table_id),
+			                                 SISTAT_Sync_Impl::Literal(bind_data.language),
+			                                 SISTAT_Sync_Impl::Literal(temp_path)));
+			auto count = copied->Cast<MaterializedQueryResult>().GetValue(0, 0);
+			row.rows = count.IsNull() ? 0 : count.GetValue<int64_t>();
+			// Data first: a reader that finds the new metadata also finds the matching rows
+			ResponseCache::ReplaceFile(fs, temp_path, row.path);
+			SistatMirror::WriteFile(fs, SistatMirror::MetadataPath(fs, bind_data.directory, row.table_id,
+			                                                       bind_data.language),
+			                        std::move(metadata));
+			row.file_size = fs.OpenFile(row.path, FileFlags::FILE_FLAGS_READ)->GetFileSize();
+			row.status = "mirrored";
+		} catch (std::exception &ex) {
+			ErrorData error(ex);
+			row.status = "failed";
+			row.rows = 0;
+			row.error = error.RawMessage();
+			try {
+				fs.RemoveFile(temp_path);
+			} catch (std::exception &) {
+				// Not written, or already renamed into place
+			}
+		}
+		row.elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	class MirrorTask final : public BaseExecutorTask {
+	public:
+		MirrorTask(TaskExecutor &executor, MirrorRun &run_p) : BaseExecutorTask(executor), run(run_p) {
+		}
+
+		void ExecuteTask() override {
+			// Failures are reported per table, so one table never stops the others
+			for (idx_t i = run.next_table++; i < run.rows.size(); i = run.next_table++) {
+				MirrorTable(run, run.rows[i]);
+			}
+		}
+
+	private:
+		MirrorRun &run;
+	};
+
+	static unique_ptr<GlobalTableFunctionState> Init(ClientContext &context, TableFunctionInitInput &input) {
+
+		auto &bind_data = input.bind_data->Cast<BindData>();
+		auto state = make_uniq_base<GlobalTableFunctionState, State>();
+		State *state_ptr = static_cast<State *>(state.get());
+
+		auto &db = DatabaseInstance::GetDatabase(context);
+		auto &fs = FileSystem::GetFileSystem(context);
+		if (!fs.DirectoryExists(bind_data.directory)) {
+			fs.CreateDirectory(bind_data.directory);
+		}
+		auto lookup = MetadataCache::CreateLookup(context, bind_data.base_url);
+		// Like the data, the metadata comes from the server rather than the snapshot being replaced
+		lookup.mirror_directory.clear();
+
+		auto &rows = state_ptr->rows;
+		rows.resize(bind_data.table_ids.size());
+		for (idx_t i = 0; i < rows.size(); i++) {
+			rows[i].table_id = bind_data.table_ids[i];
+			rows[i].path = SistatMirror::DataPath(fs, bind_data.directory, rows[i].table_id, bind_data.language);
+		}
+
+		MirrorRun run(db, fs, bind_data, lookup, rows);
+		// Always download: reading the snapshot that is being replaced would only copy it
+		case_insensitive_map_t<Value> overrides {{sistat::MIRROR_DIRECTORY_SETTING, Value("")},
+		                                         {sistat::BASE_URL_SETTING, Value(bind_data.base_url)}};
+		run.settings = SISTAT_Sync_Impl::SessionSettings(context, overrides);
+
+		// Each task copies one table at a time on its own connection
+		TaskExecutor executor(context);
+		idx_t num_tasks = MinValue<idx_t>(bind_data.concurrency, rows.size());
+		for (idx_t i = 0; i < num_tasks; i++) {
+			executor.ScheduleTask(make_uniq<MirrorTask>(executor, run));
+		}
+		executor.WorkOnTasks();
+		return std::move(state);
+	}
+
+	static void Execute(ClientContext &context, TableFunctionInput &input, DataChunk &output) {
+
+		auto &state = input.global_state->Cast<State>();
+		idx_t count = 0;
+		idx_t limit = MinValue<idx_t>(state.current_row + STANDARD_VECTOR_SIZE, state.rows.size());
+
+		for (; state.current_row < limit; state.current_row++, count++) {
+			auto &row = state.rows[state.current_row];
+			output.data[0].SetValue(count, row.table_id);
+			output.data[1].SetValue(count, row.path);
+			output.data[2].SetValue(count, row.status);
+			output.data[3].SetValue(count, Value::BIGINT(row.rows));
+			output.data[4].SetValue(count, Value::BIGINT(row.file_size));
+			output.data[5].SetValue(count, Value::DOUBLE(row.elapsed_ms));
+			output.data[6].SetValue(count, row.error.empty() ? Value() : Value(row.error));
+		}
+		output.SetCardinality(count);
+	}
+
+	static void Register(ExtensionLoader &loader) {
+
+		TableFunction func("SISTAT_Mirror", {LogicalType::LIST(LogicalType::VARCHAR)}, Execute, Bind, Init);
+		func.named_parameters["language"] = LogicalType::VARCHAR;
+		func.named_parameters["directory"] = LogicalType::VARCHAR;
+		func.named_parameters["concurrency"] = LogicalType::UBIGINT;
+		loader.RegisterFunction(func);
+	}
+};
+
+} // namespace
+
+void SistatSyncFunctions::Register(ExtensionLoader &loader) {
+	SISTAT_Sync_Impl::Register(loader);
+	SISTAT_Mirror_Impl::Register(loader);
+}
+
+} // namespace duckdb
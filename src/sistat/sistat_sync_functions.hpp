@@ -0,0 +1,10 @@
+#pragma once
+
+namespace duckdb {
+
+class ExtensionLoader;
+struct SistatSyncFunctions {
+	static void Register(ExtensionLoader &loader);
+};
+
+} // namespace duckdb
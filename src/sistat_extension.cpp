@@ -2,16 +2,69 @@
 
 #include "sistat_extension.hpp"
 #include "duckdb.hpp"
+#include "sistat/sistat_catalog.hpp"
 #include "sistat/sistat_data_functions.hpp"
 #include "sistat/sistat_info_functions.hpp"
+#include "sistat/sistat_sync_functions.hpp"
+#include "sistat/sistat.hpp"
 
+#include "duckdb/main/config.hpp"
 #include "duckdb/main/extension/extension_loader.hpp"
 
 namespace duckdb {
 
 static void LoadInternal(ExtensionLoader &loader) {
+	auto &config = DBConfig::GetConfig(loader.GetDatabaseInstance());
+	config.AddExtensionOption(sistat::BASE_URL_SETTING, "Root URL of the SiStat PxWeb API", LogicalType::VARCHAR,
+	                          Value(sistat::BASE_URL));
+	config.AddExtensionOption(sistat::MAX_CELLS_PER_REQUEST_SETTING,
+	                          "Largest number of cells SISTAT_Read requests in a single query; larger reads are split",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_MAX_CELLS_PER_REQUEST));
+	config.AddExtensionOption(sistat::MAX_CONCURRENCY_SETTING,
+	                          "Largest number of requests in flight to one SiStat host per database (global; a session "
+	                          "value only lowers the downloads one function call starts)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_MAX_CONCURRENCY));
+	config.AddExtensionOption(sistat::REQUESTS_PER_SECOND_SETTING,
+	                          "Requests per second sent to one SiStat host per database (global; 0 disables pacing)",
+	                          LogicalType::DOUBLE, Value::DOUBLE(sistat::DEFAULT_REQUESTS_PER_SECOND));
+	config.AddExtensionOption(sistat::REQUEST_BURST_SETTING,
+	                          "Requests that may be sent to one SiStat host in a burst before pacing applies (global)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_REQUEST_BURST));
+	config.AddExtensionOption(sistat::RETRIES_SETTING,
+	                          "Retries of SiStat requests failing with a transport error, 429 or 5xx",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_RETRIES));
+	config.AddExtensionOption(sistat::RETRY_WAIT_MS_SETTING, "Base backoff in milliseconds between SiStat retries",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_RETRY_WAIT_MS));
+	config.AddExtensionOption(sistat::RETRY_MAX_WAIT_MS_SETTING,
+	                          "Largest backoff in milliseconds between SiStat retries", LogicalType::UBIGINT,
+	                          Value::UBIGINT(sistat::DEFAULT_RETRY_MAX_WAIT_MS));
+	config.AddExtensionOption(sistat::PREFETCH_SETTING,
+	                          "Start downloading an unfiltered SISTAT_Read while the query is planned",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption(sistat::METADATA_CACHE_SETTING, "Cache SiStat table metadata in memory",
+	                          LogicalType::BOOLEAN, Value::BOOLEAN(true));
+	config.AddExtensionOption(sistat::METADATA_CACHE_TTL_SETTING,
+	                          "Seconds a cached SiStat table metadata entry stays valid (0 disables the cache)",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_METADATA_CACHE_TTL));
+	config.AddExtensionOption(sistat::METADATA_CACHE_MAX_ENTRIES_SETTING,
+	                          "Largest number of SiStat tables whose metadata is cached", LogicalType::UBIGINT,
+	                          Value::UBIGINT(sistat::DEFAULT_METADATA_CACHE_ENTRIES));
+	config.AddExtensionOption(sistat::CACHE_DIRECTORY_SETTING,
+	                          "Directory of the on-disk SiStat response cache (empty disables it)",
+	                          LogicalType::VARCHAR, Value(""));
+	config.AddExtensionOption(sistat::CACHE_MAX_SIZE_SETTING, "Largest size in bytes of the on-disk SiStat cache",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_CACHE_MAX_SIZE));
+	config.AddExtensionOption(sistat::CACHE_MAX_AGE_SETTING,
+	                          "Seconds a cached SiStat response is served before it is revalidated with the server",
+	                          LogicalType::UBIGINT, Value::UBIGINT(sistat::DEFAULT_CACHE_MAX_AGE));
+	config.AddExtensionOption(sistat::MIRROR_DIRECTORY_SETTING,
+	                          "Directory of SISTAT_Mirror snapshots that SISTAT_Read scans instead of downloading "
+	                          "(empty disables it)",
+	                          LogicalType::VARCHAR, Value(""));
 	SistatDataFunctions::Register(loader);
 	SistatInfoFunctions::Register(loader);
+	SistatSyncFunctions::Register(loader);
+	SistatStorageExtension::Register(loader);
 }
 
 void SistatExtension::Load(ExtensionLoader &db) {
@@ -0,0 +1,66 @@
+#!/usr/bin/env bash
+# Offline end-to-end load test: runs the load harness against the mock PxWeb server, first clean and gzipped, then
+# with injected 429/503 answers and connection resets, then through the on-disk response cache. Every scenario must
+# complete without failed queries. Build the tools first with: EXT_FLAGS=-DSISTAT_BUILD_LOAD_TOOLS=1 make
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+TOOLS_DIR="${TOOLS_DIR:-$ROOT_DIR/build/release/extension/sistat}"
+SERVER_BIN="${SERVER_BIN:-$TOOLS_DIR/mock_pxweb_server}"
+LOAD_BIN="${LOAD_BIN:-$TOOLS_DIR/sistat_load}"
+PORT="${PORT:-18765}"
+BASE_URL="http://127.0.0.1:${PORT}/SiStatData/api/v1/"
+
+for bin in "$SERVER_BIN" "$LOAD_BIN"; do
+  if [[ ! -x "$bin" ]]; then
+    echo "$bin not found; build with EXT_FLAGS=-DSISTAT_BUILD_LOAD_TOOLS=1 make" >&2
+    exit 1
+  fi
+done
+
+server_pid=""
+cache_dir="$(mktemp -d)"
+stop_server() {
+  if [[ -n "$server_pid" ]]; then
+    kill "$server_pid" 2>/dev/null || true
+    wait "$server_pid" 2>/dev/null || true
+    server_pid=""
+  fi
+}
+cleanup() {
+  stop_server
+  rm -rf "$cache_dir"
+}
+trap cleanup EXIT
+
+start_server() {
+  stop_server
+  "$SERVER_BIN" --port "$PORT" "$@" >/dev/null &
+  server_pid=$!
+  for _ in $(seq 1 50); do
+    if curl -sf "http://127.0.0.1:${PORT}/_stats" >/dev/null; then
+      return 0
+    fi
+    sleep 0.1
+  done
+  echo "mock server did not start" >&2
+  exit 1
+}
+
+# Pacing is disabled and backoff shortened so the scenarios measure the extension, not the default rate limit
+run_load() {
+  local label="$1"
+  shift
+  echo "== $label"
+  "$LOAD_BIN" --base-url "$BASE_URL" --set sistat_requests_per_second=0 --set sistat_retry_wait_ms=10 \
+    --set sistat_retry_max_wait_ms=200 "$@"
+}
+
+start_server --gzip --latency-ms 5
+run_load "clean, gzip" --connections 16 --queries 30
+
+start_server --gzip --latency-ms 5 --jitter-ms 20 --rate-429 0.05 --rate-503 0.05 --reset-rate 0.05
+run_load "429/503 and resets" --connections 16 --queries 30 --set sistat_http_retries=8
+
+start_server --latency-ms 20
+run_load "response cache" --connections 8 --queries 30 --set "sistat_cache_directory=$cache_dir"
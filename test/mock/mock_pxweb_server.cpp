@@ -0,0 +1,589 @@
+// Local stand-in for the SiStat PxWeb API, so concurrency, retries and caching can be exercised offline.
+//
+// Serves synthetic tables MOCK0001S.px, MOCK0002S.px, ... under /SiStatData/api/v1/<lang>/Data/: the catalog list
+// (GET of the directory), table metadata (GET of a table) and data queries (POST of a table, answered as json-stat,
+// json-stat2 or PX). Latency, bandwidth, 429/503 answers, connection resets and gzip are configurable, and
+// GET /_stats reports what was served and injected. Point the extension at it with
+//   SET sistat_base_url = 'http://127.0.0.1:8765/SiStatData/api/v1/';
+// Run with --help for the options.
+
+#include "httplib.hpp"
+#include "miniz.hpp"
+#include "yyjson.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using duckdb_yyjson::yyjson_arr_get;
+using duckdb_yyjson::yyjson_arr_size;
+using duckdb_yyjson::yyjson_doc;
+using duckdb_yyjson::yyjson_doc_free;
+using duckdb_yyjson::yyjson_doc_get_root;
+using duckdb_yyjson::yyjson_get_str;
+using duckdb_yyjson::yyjson_is_arr;
+using duckdb_yyjson::yyjson_is_obj;
+using duckdb_yyjson::yyjson_is_str;
+using duckdb_yyjson::yyjson_obj_get;
+using duckdb_yyjson::yyjson_read;
+using duckdb_yyjson::yyjson_val;
+
+namespace {
+
+struct Options {
+	std::string host = "127.0.0.1";
+	int port = 8765;
+	int threads = 64;
+	//! Number of tables in the catalog
+	int tables = 20;
+	//! Years of the smallest table; table i has (1 + i % 4) times as many
+	int years = 25;
+	int latency_ms = 0;
+	int jitter_ms = 0;
+	//! Response bandwidth per connection in KiB/s; 0 for unlimited
+	int bandwidth_kib = 0;
+	//! Probabilities of answering 429, answering 503, or dropping the connection halfway through the body
+	double rate_429 = 0;
+	double rate_503 = 0;
+	double reset_rate = 0;
+	//! Retry-After seconds sent with injected 429s; 0 sends none
+	int retry_after = 0;
+	//! Compress responses for clients that accept gzip
+	bool gzip = false;
+	unsigned seed = 1;
+};
+
+struct Stats {
+	std::atomic<uint64_t> requests {0};
+	std::atomic<uint64_t> catalog {0};
+	std::atomic<uint64_t> metadata {0};
+	std::atomic<uint64_t> data {0};
+	std::atomic<uint64_t> not_found {0};
+	std::atomic<uint64_t> injected_429 {0};
+	std::atomic<uint64_t> injected_503 {0};
+	std::atomic<uint64_t> resets {0};
+	std::atomic<uint64_t> gzipped {0};
+	std::atomic<uint64_t> body_bytes {0};
+};
+
+struct Variable {
+	std::string code;
+	std::string text;
+	std::vector<std::string> values;
+	std::vector<std::string> value_texts;
+	bool elimination;
+};
+
+class MockPxWeb {
+public:
+	explicit MockPxWeb(Options options_p) : options(std::move(options_p)), random(options.seed) {
+	}
+
+	void Register(duckdb_httplib::Server &server) {
+		const char *table_pattern = R"(/SiStatData/api/v1/([^/]+)/Data/([^/]+))";
+		server.Get(R"(/SiStatData/api/v1/([^/]+)/Data/?)", [this](const duckdb_httplib::Request &req,
+		                                                          duckdb_httplib::Response &res) {
+			Handle(req, res, [&]() { return Catalog(req.matches.groups[1].text); }, stats.catalog);
+		});
+		server.Get(table_pattern, [this](const duckdb_httplib::Request &req, duckdb_httplib::Response &res) {
+			Handle(req, res, [&]() { return Metadata(req.matches.groups[2].text); }, stats.metadata);
+		});
+		server.Post(table_pattern, [this](const duckdb_httplib::Request &req, duckdb_httplib::Response &res) {
+			std::string content_type;
+			Handle(req, res, [&]() { return Data(req.matches.groups[2].text, req.body, content_type); }, stats.data,
+			       &content_type);
+		});
+		server.Get("/_stats", [this](const duckdb_httplib::Request &, duckdb_httplib::Response &res) {
+			res.set_content(StatsJson(), "application/json");
+		});
+	}
+
+private:
+	//! A response body, or an HTTP error status with a message
+	struct Body {
+		int status = 200;
+		std::string text;
+	};
+
+	template <class PRODUCE>
+	void Handle(const duckdb_httplib::Request &req, duckdb_httplib::Response &res, PRODUCE produce,
+	            std::atomic<uint64_t> &counter, const std::string *content_type = nullptr) {
+		stats.requests++;
+		counter++;
+		Delay();
+		double fault = Uniform();
+		if (fault < options.rate_429) {
+			stats.injected_429++;
+			if (options.retry_after > 0) {
+				res.set_header("Retry-After", std::to_string(options.retry_after));
+			}
+			res.status = 429;
+			res.set_content("Too many requests", "text/plain");
+			return;
+		}
+		if (fault < options.rate_429 + options.rate_503) {
+			stats.injected_503++;
+			res.status = 503;
+			res.set_content("Service unavailable", "text/plain");
+			return;
+		}
+		Body body = produce();
+		if (body.status != 200) {
+			stats.not_found += body.status == 404 ? 1 : 0;
+			res.status = body.status;
+			res.set_content(body.text, "text/plain");
+			return;
+		}
+		Send(req, res, std::move(body.text),
+		     content_type && !content_type->empty() ? *content_type : std::string("application/json"));
+	}
+
+	void Send(const duckdb_httplib::Request &req, duckdb_httplib::Response &res, std::string text,
+	          const std::string &content_type) {
+		if (options.gzip && req.get_header_value("Accept-Encoding").find("gzip") != std::string::npos) {
+			text = Gzip(text);
+			res.set_header("Content-Encoding", "gzip");
+			stats.gzipped++;
+		}
+		stats.body_bytes += text.size();
+		bool reset = Uniform() < options.reset_rate;
+		if (!reset && options.bandwidth_kib <= 0) {
+			res.set_content(text, content_type);
+			return;
+		}
+		// Bodies are written in slices of a tenth of a second of bandwidth; a reset stops halfway and closes the
+		// connection, which the client sees as a truncated transfer
+		auto shared = std::make_shared<std::string>(std::move(text));
+		size_t cutoff = reset ? shared->size() / 2 : shared->size();
+		size_t slice = options.bandwidth_kib > 0 ? std::max<size_t>(options.bandwidth_kib * 1024 / 10, 1) : cutoff;
+		res.set_content_provider(
+		    shared->size(), content_type,
+		    [this, shared, cutoff, slice](size_t offset, size_t length, duckdb_httplib::DataSink &sink) {
+			    if (offset >= cutoff) {
+				    stats.resets++;
+				    return false;
+			    }
+			    size_t size = std::min(std::min(length, cutoff - offset), slice);
+			    sink.write(shared->data() + offset, size);
+			    if (options.bandwidth_kib > 0) {
+				    std::this_thread::sleep_for(std::chrono::milliseconds(100 * size / slice));
+			    }
+			    return true;
+		    });
+	}
+
+	void Delay() {
+		int delay = options.latency_ms;
+		if (options.jitter_ms > 0) {
+			delay += static_cast<int>(Uniform() * options.jitter_ms);
+		}
+		if (delay > 0) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+		}
+	}
+
+	double Uniform() {
+		std::lock_guard<std::mutex> guard(random_lock);
+		return std::uniform_real_distribution<double>(0.0, 1.0)(random);
+	}
+
+	static std::string TableId(int table) {
+		char id[32];
+		snprintf(id, sizeof(id), "MOCK%04dS.px", table);
+		return id;
+	}
+
+	//! Table number of an id, or 0 when it is not one of the mock tables
+	int TableNumber(const std::string &id) const {
+		int table = 0;
+		char suffix[8] = {0};
+		if (sscanf(id.c_str(), "MOCK%4dS.%3s", &table, suffix) != 2 || strcmp(suffix, "px") != 0) {
+			return 0;
+		}
+		return table >= 1 && table <= options.tables ? table : 0;
+	}
+
+	std::vector<Variable> Variables(int table) const {
+		std::vector<Variable> variables;
+		Variable region {"REGIJA", "REGION", {}, {}, true};
+		for (int i = 0; i < 12; i++) {
+			region.values.push_back(std::to_string(i));
+			region.value_texts.push_back(i == 0 ? "SLOVENIA" : "Region " + std::to_string(i));
+		}
+		variables.push_back(std::move(region));
+		variables.push_back({"SPOL", "SEX", {"0", "1", "2"}, {"Sex - TOTAL", "Men", "Women"}, true});
+		Variable year {"LETO", "YEAR", {}, {}, false};
+		int years = options.years * (1 + table % 4);
+		for (int i = 0; i < years; i++) {
+			year.values.push_back(std::to_string(2000 + i));
+			year.value_texts.push_back(year.values.back());
+		}
+		variables.push_back(std::move(year));
+		return variables;
+	}
+
+	//! Deterministic cell of a table, by position along every variable; false for a missing value
+	static bool CellValue(int table, const std::vector<size_t> &positions, double &value) {
+		uint64_t hash = static_cast<uint64_t>(table) * 1000003ULL;
+		for (auto position : positions) {
+			hash = (hash ^ (position + 0x9e3779b97f4a7c15ULL)) * 0x100000001b3ULL;
+		}
+		if (hash % 97 == 0) {
+			return false;
+		}
+		value = static_cast<double>(hash % 1000000) / 10.0;
+		return true;
+	}
+
+	static std::string Quote(const std::string &text) {
+		std::string result = "\"";
+		for (char c : text) {
+			if (c == '"' || c == '\\') {
+				result += '\\';
+			}
+			result += c;
+		}
+		return result + "\"";
+	}
+
+	Body Catalog(const std::string &lang) {
+		std::string json = "[";
+		for (int table = 1; table <= options.tables; table++) {
+			json += table > 1 ? "," : "";
+			json += "{\"id\":" + Quote(TableId(table)) + ",\"type\":\"t\",\"text\":" +
+			        Quote("Mock table " + std::to_string(table) + " (" + lang + ")") +
+			        ",\"updated\":\"2024-01-01T00:00:00\"}";
+		}
+		return {200, json + "]"};
+	}
+
+	Body Metadata(const std::string &id) {
+		int table = TableNumber(id);
+		if (table == 0) {
+			return {404, "Table not found"};
+		}
+		std::string json = "{\"title\":" + Quote("Mock table " + std::to_string(table)) + ",\"variables\":[";
+		auto variables = Variables(table);
+		for (size_t v = 0; v < variables.size(); v++) {
+			auto &variable = variables[v];
+			json += v > 0 ? "," : "";
+			json += "{\"code\":" + Quote(variable.code) + ",\"text\":" + Quote(variable.text) + ",\"values\":[";
+			for (size_t i = 0; i < variable.values.size(); i++) {
+				json += (i > 0 ? "," : "") + Quote(variable.values[i]);
+			}
+			json += "],\"valueTexts\":[";
+			for (size_t i = 0; i < variable.value_texts.size(); i++) {
+				json += (i > 0 ? "," : "") + Quote(variable.value_texts[i]);
+			}
+			json += std::string("],\"elimination\":") + (variable.elimination ? "true" : "false") + "}";
+		}
+		return {200, json + "]}"};
+	}
+
+	//! Answer a data query: the selected positions of every requested variable, with the variables the query leaves
+	//! out fixed to their first value (the total), as PxWeb does for eliminated variables
+	Body Data(const std::string &id, const std::string &query_json, std::string &content_type) {
+		int table = TableNumber(id);
+		if (table == 0) {
+			return {404, "Table not found"};
+		}
+		auto variables = Variables(table);
+		std::vector<std::vector<size_t>> selected(variables.size());
+		std::vector<bool> requested(variables.size(), false);
+		std::string format = "json-stat";
+
+		yyjson_doc *doc = yyjson_read(query_json.c_str(), query_json.size(), 0);
+		yyjson_val *root = doc ? yyjson_doc_get_root(doc) : nullptr;
+		if (!yyjson_is_obj(root)) {
+			yyjson_doc_free(doc);
+			return {400, "Invalid query"};
+		}
+		yyjson_val *response = yyjson_obj_get(root, "response");
+		if (yyjson_is_obj(response) && yyjson_is_str(yyjson_obj_get(response, "format"))) {
+			format = yyjson_get_str(yyjson_obj_get(response, "format"));
+		}
+		yyjson_val *query = yyjson_obj_get(root, "query");
+		bool all = !yyjson_is_arr(query) || yyjson_arr_size(query) == 0;
+		for (size_t q = 0; !all && q < yyjson_arr_size(query); q++) {
+			yyjson_val *entry = yyjson_arr_get(query, q);
+			yyjson_val *code = yyjson_obj_get(entry, "code");
+			yyjson_val *selection = yyjson_obj_get(entry, "selection");
+			size_t v = 0;
+			while (v < variables.size() && (!yyjson_is_str(code) || variables[v].code != yyjson_get_str(code))) {
+				v++;
+			}
+			if (v == variables.size() || !yyjson_is_obj(selection)) {
+				yyjson_doc_free(doc);
+				return {400, "Unknown variable in query"};
+			}
+			requested[v] = true;
+			yyjson_val *filter = yyjson_obj_get(selection, "filter");
+			yyjson_val *values = yyjson_obj_get(selection, "values");
+			bool select_all = yyjson_is_str(filter) && std::string(yyjson_get_str(filter)) == "all";
+			for (size_t i = 0; i < variables[v].values.size(); i++) {
+				bool match = select_all;
+				for (size_t j = 0; !match && yyjson_is_arr(values) && j < yyjson_arr_size(values); j++) {
+					yyjson_val *value = yyjson_arr_get(values, j);
+					match = yyjson_is_str(value) && variables[v].values[i] == yyjson_get_str(value);
+				}
+				if (match) {
+					selected[v].push_back(i);
+				}
+			}
+		}
+		yyjson_doc_free(doc);
+
+		std::vector<size_t> dims;
+		for (size_t v = 0; v < variables.size(); v++) {
+			if (all || requested[v]) {
+				if (all) {
+					for (size_t i = 0; i < variables[v].values.size(); i++) {
+						selected[v].push_back(i);
+					}
+				}
+				dims.push_back(v);
+			} else if (!variables[v].elimination) {
+				return {400, "Variable " + variables[v].code + " cannot be eliminated"};
+			} else {
+				selected[v].push_back(0);
+			}
+		}
+
+		// Cells in row-major order over the requested variables
+		size_t cells = 1;
+		for (auto v : dims) {
+			cells *= selected[v].size();
+		}
+		std::vector<double> values(cells);
+		std::vector<bool> present(cells);
+		// Eliminated variables keep position 0
+		std::vector<size_t> positions(variables.size(), 0);
+		for (size_t cell = 0; cell < cells; cell++) {
+			size_t rest = cell;
+			for (size_t d = dims.size(); d-- > 0;) {
+				auto &sel = selected[dims[d]];
+				positions[dims[d]] = sel[rest % sel.size()];
+				rest /= sel.size();
+			}
+			present[cell] = CellValue(table, positions, values[cell]);
+		}
+
+		if (format == "px") {
+			content_type = "text/plain; charset=windows-1250";
+			return {200, Px(table, variables, dims, selected, values, present)};
+		}
+		if (format != "json-stat" && format != "json-stat2") {
+			return {400, "Unsupported format " + format};
+		}
+		return {200, JsonStat(format == "json-stat2", table, variables, dims, selected, values, present)};
+	}
+
+	static std::string FormatValue(double value) {
+		char buffer[32];
+		snprintf(buffer, sizeof(buffer), "%.1f", value);
+		return buffer;
+	}
+
+	static std::string JsonStat(bool version2, int table, const std::vector<Variable> &variables,
+	                            const std::vector<size_t> &dims, const std::vector<std::vector<size_t>> &selected,
+	                            const std::vector<double> &values, const std::vector<bool> &present) {
+		std::string ids;
+		std::string sizes;
+		std::string dimension;
+		for (size_t d = 0; d < dims.size(); d++) {
+			auto &variable = variables[dims[d]];
+			auto &sel = selected[dims[d]];
+			ids += (d > 0 ? "," : "") + Quote(variable.code);
+			sizes += (d > 0 ? "," : "") + std::to_string(sel.size());
+			std::string index;
+			std::string label;
+			for (size_t i = 0; i < sel.size(); i++) {
+				auto &code = variable.values[sel[i]];
+				index += (i > 0 ? "," : "") + Quote(code) + ":" + std::to_string(i);
+				label += (i > 0 ? "," : "") + Quote(code) + ":" + Quote(variable.value_texts[sel[i]]);
+			}
+			dimension += (d > 0 ? "," : "") + Quote(variable.code) + ":{\"label\":" + Quote(variable.text) +
+			             ",\"category\":{\"index\":{" + index + "},\"label\":{" + label + "}}}";
+		}
+		std::string value;
+		std::string status;
+		for (size_t cell = 0; cell < values.size(); cell++) {
+			value += cell > 0 ? "," : "";
+			if (present[cell]) {
+				value += FormatValue(values[cell]);
+			} else {
+				value += "null";
+				status += (status.empty() ? "" : ",") + Quote(std::to_string(cell)) + ":\"..\"";
+			}
+		}
+		std::string label = Quote("Mock table " + std::to_string(table));
+		if (version2) {
+			return "{\"class\":\"dataset\",\"version\":\"2.0\",\"label\":" + label + ",\"id\":[" + ids +
+			       "],\"size\":[" + sizes + "],\"dimension\":{" + dimension + "},\"value\":[" + value +
+			       "],\"status\":{" + status + "}}";
+		}
+		return "{\"dataset\":{\"label\":" + label + ",\"dimension\":{" + dimension + ",\"id\":[" + ids +
+		       "],\"size\":[" + sizes + "]},\"value\":[" + value + "],\"status\":{" + status + "}}}";
+	}
+
+	static std::string Px(int table, const std::vector<Variable> &variables, const std::vector<size_t> &dims,
+	                      const std::vector<std::vector<size_t>> &selected, const std::vector<double> &values,
+	                      const std::vector<bool> &present) {
+		auto list = [&](size_t v, const std::vector<std::string> &items) {
+			std::string result;
+			for (size_t i = 0; i < selected[v].size(); i++) {
+				result += (i > 0 ? "," : "") + Quote(items[selected[v][i]]);
+			}
+			return result;
+		};
+		std::string px = "CHARSET=\"ANSI\";\nMATRIX=\"MOCK" + std::to_string(table) + "\";\n";
+		px += "TITLE=" + Quote("Mock table " + std::to_string(table)) + ";\n";
+		std::string stub;
+		for (size_t d = 0; d + 1 < dims.size(); d++) {
+			stub += (d > 0 ? "," : "") + Quote(variables[dims[d]].text);
+		}
+		px += "STUB=" + stub + ";\n";
+		px += "HEADING=" + (dims.empty() ? std::string() : Quote(variables[dims.back()].text)) + ";\n";
+		for (auto v : dims) {
+			auto &variable = variables[v];
+			px += "VALUES(" + Quote(variable.text) + ")=" + list(v, variable.value_texts) + ";\n";
+			px += "CODES(" + Quote(variable.text) + ")=" + list(v, variable.values) + ";\n";
+		}
+		px += "DATA=\n";
+		size_t row = dims.empty() ? 1 : selected[dims.back()].size();
+		for (size_t cell = 0; cell < values.size(); cell++) {
+			px += present[cell] ? FormatValue(values[cell]) : "\"..\"";
+			px += (cell + 1) % row == 0 ? "\n" : " ";
+		}
+		return px + ";\n";
+	}
+
+	static std::string Gzip(const std::string &data) {
+		using namespace duckdb_miniz;
+		mz_stream stream;
+		memset(&stream, 0, sizeof(stream));
+		mz_deflateInit2(&stream, MZ_DEFAULT_COMPRESSION, MZ_DEFLATED, -MZ_DEFAULT_WINDOW_BITS, 9, MZ_DEFAULT_STRATEGY);
+		std::string result("\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10);
+		size_t header_size = result.size();
+		result.resize(header_size + mz_deflateBound(&stream, data.size()));
+		stream.next_in = reinterpret_cast<const unsigned char *>(data.data());
+		stream.avail_in = static_cast<unsigned int>(data.size());
+		stream.next_out = reinterpret_cast<unsigned char *>(&result[header_size]);
+		stream.avail_out = static_cast<unsigned int>(result.size() - header_size);
+		mz_deflate(&stream, MZ_FINISH);
+		result.resize(header_size + stream.total_out);
+		mz_deflateEnd(&stream);
+		auto crc = static_cast<uint32_t>(
+		    mz_crc32(MZ_CRC32_INIT, reinterpret_cast<const unsigned char *>(data.data()), data.size()));
+		auto size = static_cast<uint32_t>(data.size());
+		for (auto word : {crc, size}) {
+			for (int i = 0; i < 4; i++) {
+				result += static_cast<char>((word >> (8 * i)) & 0xff);
+			}
+		}
+		return result;
+	}
+
+	std::string StatsJson() const {
+		auto field = [](const char *name, const std::atomic<uint64_t> &value) {
+			return Quote(name) + ":" + std::to_string(value.load());
+		};
+		return "{" + field("requests", stats.requests) + "," + field("catalog", stats.catalog) + "," +
+		       field("metadata", stats.metadata) + "," + field("data", stats.data) + "," +
+		       field("not_found", stats.not_found) + "," + field("injected_429", stats.injected_429) + "," +
+		       field("injected_503", stats.injected_503) + "," + field("resets", stats.resets) + "," +
+		       field("gzipped", stats.gzipped) + "," + field("body_bytes", stats.body_bytes) + "}";
+	}
+
+	Options options;
+	Stats stats;
+	std::mutex random_lock;
+	std::mt19937_64 random;
+};
+
+void Usage() {
+	std::cerr << "Usage: mock_pxweb_server [options]\n"
+	             "  --host H            address to listen on (127.0.0.1)\n"
+	             "  --port N            port to listen on (8765)\n"
+	             "  --threads N         worker threads, one per open connection (64)\n"
+	             "  --tables N          tables in the catalog (20)\n"
+	             "  --years N           years of the smallest table; a table has 36 cells per year (25)\n"
+	             "  --latency-ms N      delay before every response (0)\n"
+	             "  --jitter-ms N       random extra delay of up to N ms (0)\n"
+	             "  --bandwidth-kib N   body bandwidth per connection in KiB/s, 0 for unlimited (0)\n"
+	             "  --rate-429 P        share of requests answered with 429 (0)\n"
+	             "  --rate-503 P        share of requests answered with 503 (0)\n"
+	             "  --reset-rate P      share of bodies cut off halfway by closing the connection (0)\n"
+	             "  --retry-after S     Retry-After seconds sent with 429 answers, 0 for none (0)\n"
+	             "  --gzip              gzip bodies for clients that accept it\n"
+	             "  --seed N            seed of the fault injection (1)\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		auto next = [&]() -> std::string {
+			if (i + 1 >= argc) {
+				Usage();
+				exit(1);
+			}
+			return argv[++i];
+		};
+		if (arg == "--host") {
+			options.host = next();
+		} else if (arg == "--port") {
+			options.port = std::stoi(next());
+		} else if (arg == "--threads") {
+			options.threads = std::stoi(next());
+		} else if (arg == "--tables") {
+			options.tables = std::stoi(next());
+		} else if (arg == "--years") {
+			options.years = std::stoi(next());
+		} else if (arg == "--latency-ms") {
+			options.latency_ms = std::stoi(next());
+		} else if (arg == "--jitter-ms") {
+			options.jitter_ms = std::stoi(next());
+		} else if (arg == "--bandwidth-kib") {
+			options.bandwidth_kib = std::stoi(next());
+		} else if (arg == "--rate-429") {
+			options.rate_429 = std::stod(next());
+		} else if (arg == "--rate-503") {
+			options.rate_503 = std::stod(next());
+		} else if (arg == "--reset-rate") {
+			options.reset_rate = std::stod(next());
+		} else if (arg == "--retry-after") {
+			options.retry_after = std::stoi(next());
+		} else if (arg == "--gzip") {
+			options.gzip = true;
+		} else if (arg == "--seed") {
+			options.seed = static_cast<unsigned>(std::stoul(next()));
+		} else {
+			Usage();
+			return arg == "--help" ? 0 : 1;
+		}
+	}
+
+	duckdb_httplib::Server server;
+	int threads = options.threads;
+	server.new_task_queue = [threads] { return new duckdb_httplib::ThreadPool(threads); };
+	MockPxWeb mock(options);
+	mock.Register(server);
+	std::cout << "mock PxWeb listening on http://" << options.host << ":" << options.port << "/SiStatData/api/v1/"
+	          << std::endl;
+	if (!server.listen(options.host, options.port)) {
+		std::cerr << "could not listen on " << options.host << ":" << options.port << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,272 @@
+// Load harness for the sistat extension: runs concurrent DuckDB connections issuing a mix of SISTAT_Read and
+// SISTAT_Tables queries against a PxWeb server (normally mock_pxweb_server) and reports throughput, p50/p99 latency
+// and the client's request counters from SISTAT_Stats(). With the mock server, its /_stats also reports what it served
+// and the faults it injected; every injected fault costs one retry, unless the query failed after running out of them.
+// Run with --help for the options.
+
+#include "duckdb.hpp"
+#include "httplib.hpp"
+#include "sistat_extension.hpp"
+#include "yyjson.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using duckdb_yyjson::yyjson_doc;
+using duckdb_yyjson::yyjson_doc_free;
+using duckdb_yyjson::yyjson_doc_get_root;
+using duckdb_yyjson::yyjson_get_str;
+using duckdb_yyjson::yyjson_get_uint;
+using duckdb_yyjson::yyjson_is_obj;
+using duckdb_yyjson::yyjson_is_uint;
+using duckdb_yyjson::yyjson_read;
+using duckdb_yyjson::yyjson_val;
+
+namespace {
+
+struct Options {
+	std::string base_url = "http://127.0.0.1:8765/SiStatData/api/v1/";
+	int connections = 8;
+	int queries = 50;
+	int tables = 20;
+	//! Share of queries that read a table; the others list the catalog
+	double read_share = 0.8;
+	//! Extension settings applied to every connection, as name=value
+	std::vector<std::string> settings;
+	bool allow_failures = false;
+	unsigned seed = 1;
+};
+
+struct Result {
+	std::mutex lock;
+	std::map<std::string, std::vector<double>> latencies_ms;
+	std::map<std::string, uint64_t> failures;
+	std::map<std::string, std::string> first_errors;
+};
+
+std::string Quote(const std::string &text) {
+	std::string result = "'";
+	for (char c : text) {
+		result += c;
+		if (c == '\'') {
+			result += '\'';
+		}
+	}
+	return result + "'";
+}
+
+//! Scheme, host and port of a URL
+std::string Origin(const std::string &url) {
+	auto scheme_end = url.find("://");
+	auto path_start = url.find('/', scheme_end == std::string::npos ? 0 : scheme_end + 3);
+	return path_start == std::string::npos ? url : url.substr(0, path_start);
+}
+
+//! Counters of the mock server; empty when the server does not provide them
+std::map<std::string, uint64_t> ServerStats(const Options &options) {
+	std::map<std::string, uint64_t> stats;
+	duckdb_httplib::Client client(Origin(options.base_url));
+	auto res = client.Get("/_stats");
+	if (!res || res->status != 200) {
+		return stats;
+	}
+	yyjson_doc *doc = yyjson_read(res->body.c_str(), res->body.size(), 0);
+	yyjson_val *root = doc ? yyjson_doc_get_root(doc) : nullptr;
+	if (yyjson_is_obj(root)) {
+		size_t idx, max;
+		yyjson_val *key, *value;
+		yyjson_obj_foreach(root, idx, max, key, value) {
+			if (yyjson_is_uint(value)) {
+				stats[yyjson_get_str(key)] = yyjson_get_uint(value);
+			}
+		}
+	}
+	yyjson_doc_free(doc);
+	return stats;
+}
+
+void RunConnection(duckdb::DuckDB &db, const Options &options, int index, Result &result) {
+	duckdb::Connection con(db);
+	std::vector<std::string> setup {"SET sistat_base_url = " + Quote(options.base_url)};
+	for (auto &setting : options.settings) {
+		auto eq = setting.find('=');
+		setup.push_back("SET " + setting.substr(0, eq) + " = " + Quote(setting.substr(eq + 1)));
+	}
+	for (auto &statement : setup) {
+		auto res = con.Query(statement);
+		if (res->HasError()) {
+			std::lock_guard<std::mutex> guard(result.lock);
+			result.failures["setup"]++;
+			result.first_errors.emplace("setup", res->GetError());
+			return;
+		}
+	}
+
+	std::mt19937 random(options.seed + static_cast<unsigned>(index));
+	std::uniform_real_distribution<double> uniform(0.0, 1.0);
+	for (int q = 0; q < options.queries; q++) {
+		std::string kind;
+		std::string sql;
+		if (uniform(random) < options.read_share) {
+			char table[16];
+			snprintf(table, sizeof(table), "MOCK%04dS", 1 + static_cast<int>(random() % options.tables));
+			bool filtered = uniform(random) < 0.5;
+			kind = filtered ? "read_filtered" : "read";
+			sql = std::string("SELECT COUNT(*), SUM(value) FROM SISTAT_Read('") + table + "')" +
+			      (filtered ? " WHERE \"SPOL\" = '1'" : "");
+		} else {
+			kind = "tables";
+			sql = "SELECT COUNT(*) FROM SISTAT_Tables()";
+		}
+		auto start = std::chrono::steady_clock::now();
+		auto res = con.Query(sql);
+		auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		std::lock_guard<std::mutex> guard(result.lock);
+		if (res->HasError()) {
+			result.failures[kind]++;
+			result.first_errors.emplace(kind, res->GetError());
+		} else {
+			result.latencies_ms[kind].push_back(elapsed);
+		}
+	}
+}
+
+double Percentile(std::vector<double> values, double p) {
+	if (values.empty()) {
+		return 0;
+	}
+	std::sort(values.begin(), values.end());
+	auto rank = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + 0.5);
+	return values[std::min(rank, values.size() - 1)];
+}
+
+void Usage() {
+	std::cerr << "Usage: sistat_load [options]\n"
+	             "  --base-url URL       PxWeb API root (http://127.0.0.1:8765/SiStatData/api/v1/)\n"
+	             "  --connections N      concurrent DuckDB connections (8)\n"
+	             "  --queries N          queries per connection (50)\n"
+	             "  --tables N           mock tables to read from, MOCK0001S..MOCK<N>S (20)\n"
+	             "  --read-share P       share of SISTAT_Read queries; the rest run SISTAT_Tables (0.8)\n"
+	             "  --set NAME=VALUE     extension setting for every connection, repeatable\n"
+	             "                       (e.g. --set sistat_requests_per_second=0)\n"
+	             "  --allow-failures     exit with 0 even if queries failed\n"
+	             "  --seed N             seed of the query mix (1)\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+	Options options;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		auto next = [&]() -> std::string {
+			if (i + 1 >= argc) {
+				Usage();
+				exit(1);
+			}
+			return argv[++i];
+		};
+		if (arg == "--base-url") {
+			options.base_url = next();
+		} else if (arg == "--connections") {
+			options.connections = std::stoi(next());
+		} else if (arg == "--queries") {
+			options.queries = std::stoi(next());
+		} else if (arg == "--tables") {
+			options.tables = std::stoi(next());
+		} else if (arg == "--read-share") {
+			options.read_share = std::stod(next());
+		} else if (arg == "--set") {
+			options.settings.push_back(next());
+		} else if (arg == "--allow-failures") {
+			options.allow_failures = true;
+		} else if (arg == "--seed") {
+			options.seed = static_cast<unsigned>(std::stoul(next()));
+		} else {
+			Usage();
+			return arg == "--help" ? 0 : 1;
+		}
+	}
+
+	duckdb::DuckDB db(nullptr);
+	db.LoadStaticExtension<duckdb::SistatExtension>();
+
+	auto before = ServerStats(options);
+	Result result;
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> threads;
+	for (int c = 0; c < options.connections; c++) {
+		threads.emplace_back(RunConnection, std::ref(db), std::cref(options), c, std::ref(result));
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	auto after = ServerStats(options);
+	duckdb::Connection con(db);
+	auto client = con.Query("SELECT requests, retries, connections_opened, connections_reused, wire_bytes, "
+	                        "disk_cache_hits, disk_cache_misses FROM SISTAT_Stats()");
+
+	uint64_t succeeded = 0;
+	uint64_t failed = 0;
+	std::vector<double> all;
+	printf("%-14s %8s %8s %10s %10s\n", "query", "ok", "failed", "p50_ms", "p99_ms");
+	std::map<std::string, bool> kinds;
+	for (auto &entry : result.latencies_ms) {
+		kinds[entry.first] = true;
+	}
+	for (auto &entry : result.failures) {
+		kinds[entry.first] = true;
+	}
+	for (auto &kind : kinds) {
+		auto &latencies = result.latencies_ms[kind.first];
+		auto failures = result.failures[kind.first];
+		printf("%-14s %8zu %8llu %10.1f %10.1f\n", kind.first.c_str(), latencies.size(),
+		       static_cast<unsigned long long>(failures), Percentile(latencies, 0.5), Percentile(latencies, 0.99));
+		succeeded += latencies.size();
+		failed += failures;
+		all.insert(all.end(), latencies.begin(), latencies.end());
+	}
+	printf("%-14s %8llu %8llu %10.1f %10.1f\n", "all", static_cast<unsigned long long>(succeeded),
+	       static_cast<unsigned long long>(failed), Percentile(all, 0.5), Percentile(all, 0.99));
+	printf("\n%d connections, %.2f s, %.1f queries/s\n", options.connections, seconds,
+	       static_cast<double>(succeeded + failed) / seconds);
+
+	if (!client->HasError()) {
+		auto row = client->Fetch();
+		auto count = [&](duckdb::idx_t col) {
+			return static_cast<unsigned long long>(row->GetValue(col, 0).GetValue<int64_t>());
+		};
+		printf("client: %llu requests, %llu retries, %llu connections opened, %llu reused, %llu wire bytes, "
+		       "%llu/%llu disk cache hits/misses\n",
+		       count(0), count(1), count(2), count(3), count(4), count(5), count(6));
+	}
+	if (!after.empty()) {
+		auto delta = [&](const char *name) {
+			return after[name] - before[name];
+		};
+		auto retries = delta("injected_429") + delta("injected_503") + delta("resets");
+		printf("server: %llu requests (%llu catalog, %llu metadata, %llu data), %llu gzipped, %llu body bytes\n",
+		       static_cast<unsigned long long>(delta("requests")), static_cast<unsigned long long>(delta("catalog")),
+		       static_cast<unsigned long long>(delta("metadata")), static_cast<unsigned long long>(delta("data")),
+		       static_cast<unsigned long long>(delta("gzipped")),
+		       static_cast<unsigned long long>(delta("body_bytes")));
+		printf("retries: %llu (%llu x 429, %llu x 503, %llu resets)\n", static_cast<unsigned long long>(retries),
+		       static_cast<unsigned long long>(delta("injected_429")),
+		       static_cast<unsigned long long>(delta("injected_503")),
+		       static_cast<unsigned long long>(delta("resets")));
+	}
+	for (auto &error : result.first_errors) {
+		printf("first %s error: %s\n", error.first.c_str(), error.second.c_str());
+	}
+	return failed > 0 && !options.allow_failures ? 1 : 0;
+}